@@ -0,0 +1,193 @@
+/*********************************************************************
+** Program Filename: ActionLog.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared in the ActionLog header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include "ActionLog.h"
+#include "Checkpoint.h"
+#include "Simulation.h"
+
+namespace {
+
+const unsigned kNumPlayerActions = 6;
+const unsigned kNumMoveResults = 5;
+const unsigned kNumTaBehaviors = 2;
+
+/*********************************************************************
+** Function: MoveResultName
+** Description: Returns a short description of a move result, for messages.
+** Parameters: result is the move result.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+const char* MoveResultName(MoveResult result) {
+  switch (result) {
+    case MoveResult::AcquiredSkill: return "acquired a skill";
+    case MoveResult::CaughtByTA: return "caught by a TA";
+    case MoveResult::FailedByInstructor: return "failed by the instructor";
+    case MoveResult::NoEvent: return "no event";
+    case MoveResult::SatisfiedInstructor: return "satisfied the instructor";
+  }
+  return "unknown";
+}
+
+}  // namespace
+
+/*********************************************************************
+** Function: ActionLogWriter
+** Description: Constructor for the ActionLogWriter class; creates the log and
+ * writes the game's current state to it as the starting state.
+** Parameters: path is the path of the log to create; maze is the game's maze.
+** Pre-Conditions: None
+** Post-Conditions: Throws if the log can't be written.
+*********************************************************************/
+ActionLogWriter::ActionLogWriter(const std::string& path, Maze& maze):
+    path_(path), os_(path, std::ios::binary | std::ios::trunc) {
+  std::ostringstream checkpoint;
+  maze.SaveCheckpoint(checkpoint);
+  const std::string& bytes = checkpoint.str();
+
+  CheckpointWriter header;
+  header.PutBytes(kActionLogMagic, sizeof(kActionLogMagic));
+  header.Put(kActionLogVersion);
+  header.Put(static_cast<std::uint32_t>(maze.ta_behavior()));
+  header.Put(static_cast<std::uint32_t>(bytes.size()));
+  header.PutBytes(bytes.data(), bytes.size());
+  header.WriteTo(os_);
+  os_.flush();
+
+  if (!os_) throw std::runtime_error("Unable to write " + path_ + ".");
+}
+
+/*********************************************************************
+** Function: Record
+** Description: Appends a turn to the log.
+** Parameters: action is the action the student took; result is the turn's
+ * result, before any reset it caused.
+** Pre-Conditions: None
+** Post-Conditions: Throws if the log can't be written.
+*********************************************************************/
+void ActionLogWriter::Record(PlayerAction action, MoveResult result) {
+  os_.put(static_cast<char>(static_cast<unsigned>(action) |
+                            (static_cast<unsigned>(result) << 4)));
+  os_.flush();
+
+  if (!os_) throw std::runtime_error("Unable to write " + path_ + ".");
+}
+
+/*********************************************************************
+** Function: ActionLog
+** Description: Constructor for the ActionLog class; reads and checks a whole
+ * action log.
+** Parameters: is is the stream to read the log from.
+** Pre-Conditions: None
+** Post-Conditions: Throws if the log is invalid.
+*********************************************************************/
+ActionLog::ActionLog(std::istream& is) {
+  // The log uses the same integer encoding as a checkpoint.
+  CheckpointReader reader(is);
+  if (memcmp(reader.GetBytes(sizeof(kActionLogMagic)), kActionLogMagic,
+             sizeof(kActionLogMagic)) != 0) {
+    throw std::runtime_error("File is not an action log.");
+  }
+
+  std::uint32_t version = reader.Get<std::uint32_t>();
+  if (version == 0 || version > kActionLogVersion) {
+    throw std::runtime_error("Action log has unsupported version " +
+                             std::to_string(version) + ".");
+  }
+
+  if (version >= 2) {
+    std::uint32_t behavior = reader.Get<std::uint32_t>();
+    if (behavior >= kNumTaBehaviors)
+      throw std::runtime_error("Action log has an invalid TA behavior.");
+    ta_behavior_ = static_cast<TaBehavior>(behavior);
+  }
+
+  std::uint32_t checkpoint_size = reader.Get<std::uint32_t>();
+  checkpoint_.assign(reader.GetBytes(checkpoint_size), checkpoint_size);
+  while (!reader.AtEnd())
+    turns_ += static_cast<char>(reader.Get<std::uint8_t>());
+
+  for (std::size_t i = 0; i != turns_.size(); ++i) {
+    if (static_cast<unsigned>(action(i)) >= kNumPlayerActions ||
+        static_cast<unsigned>(result(i)) >= kNumMoveResults) {
+      throw std::runtime_error("Action log has an invalid turn " +
+                               std::to_string(i + 1) + ".");
+    }
+  }
+}
+
+/*********************************************************************
+** Function: ChooseAction
+** Description: Returns the next action in the log.
+** Parameters: maze is the game's maze; valid_actions are the actions the
+ * student may take.
+** Pre-Conditions: None
+** Post-Conditions: Throws if the log has no more turns or its next action
+ * isn't one of valid_actions.
+*********************************************************************/
+PlayerAction ReplayStudentPolicy::ChooseAction(Maze&,
+    const std::vector<PlayerAction>& valid_actions) {
+  if (turn_ == log_.turns())
+    throw std::runtime_error("Replay ran past the end of the action log.");
+
+  PlayerAction action = log_.action(turn_++);
+  if (std::find(valid_actions.begin(), valid_actions.end(), action) ==
+      valid_actions.end()) {
+    throw std::runtime_error("Replay diverged on turn " +
+                             std::to_string(turn_) +
+                             ": the logged action is not valid there.");
+  }
+
+  return action;
+}
+
+/*********************************************************************
+** Function: ReplayActionLog
+** Description: Restores the log's starting state and TA behavior and plays
+ * every logged turn headlessly, as fast as possible, checking that each turn
+ * has the same result as it did when it was recorded.
+** Parameters: maze is a maze loaded from the file the log was recorded on;
+ * log is the action log.
+** Pre-Conditions: None
+** Post-Conditions: Returns the number of turns played; throws at the first
+ * turn that doesn't match the log. The maze is left without a student policy
+ * and with the TA behavior it had before.
+*********************************************************************/
+unsigned long ReplayActionLog(Maze& maze, const ActionLog& log) {
+  std::istringstream checkpoint(log.checkpoint());
+  maze.LoadCheckpoint(checkpoint);
+
+  TaBehavior behavior = maze.ta_behavior();
+  maze.set_ta_behavior(log.ta_behavior());
+  ReplayStudentPolicy policy(log);
+  maze.set_student_policy(&policy);
+
+  try {
+    for (std::size_t turn = 0; turn != log.turns(); ++turn) {
+      MoveResult result = PlayTurn(maze);
+      if (result != log.result(turn)) {
+        throw std::runtime_error(
+            "Replay diverged on turn " + std::to_string(turn + 1) +
+            ": expected \"" + MoveResultName(log.result(turn)) +
+            "\" but got \"" + MoveResultName(result) + "\".");
+      }
+    }
+  } catch (...) {
+    maze.set_student_policy(nullptr);
+    maze.set_ta_behavior(behavior);
+    throw;
+  }
+
+  maze.set_student_policy(nullptr);
+  maze.set_ta_behavior(behavior);
+  return log.turns();
+}
@@ -0,0 +1,90 @@
+#ifndef ESCAPEFROMCS162_ACTIONLOG_H
+#define ESCAPEFROMCS162_ACTIONLOG_H
+/*********************************************************************
+** Program Filename: ActionLog.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares classes for recording a game as a log of the
+ * student's actions and for replaying such a log.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "Maze.h"
+#include "StudentPolicy.h"
+
+// An action log records a game as its starting state plus one byte per turn.
+// Since every random choice the maze makes comes from the generators saved in
+// the starting state, the student's actions are all that is needed to play
+// the game again exactly. All integers are little-endian:
+//
+//   char     magic[8]              "ESCALOG\0"
+//   uint32   version               kActionLogVersion
+//   uint32   ta_behavior           the maze's TaBehavior (absent in version 1
+//                                  logs, whose TAs all wander)
+//   uint32   checkpoint_size
+//   char     checkpoint[checkpoint_size]  Maze::SaveCheckpoint at the start
+//
+// followed by one byte per turn until the end of the file: the PlayerAction
+// the student took in the low four bits, and the MoveResult of the turn in
+// the high four bits.
+const char kActionLogMagic[8] = {'E', 'S', 'C', 'A', 'L', 'O', 'G', '\0'};
+const std::uint32_t kActionLogVersion = 2;
+
+// Appends each turn of a game to an action log as it is played. Every turn
+// is flushed, so the log survives the game being killed.
+class ActionLogWriter {
+  public:
+    ActionLogWriter(const std::string& path, Maze& maze);
+
+    void Record(PlayerAction action, MoveResult result);
+
+  private:
+    std::string path_;
+    std::ofstream os_;
+};
+
+// An action log read back into memory.
+class ActionLog {
+  public:
+    explicit ActionLog(std::istream& is);
+
+    TaBehavior ta_behavior() const { return ta_behavior_; }
+    const std::string& checkpoint() const { return checkpoint_; }
+    std::size_t turns() const { return turns_.size(); }
+    PlayerAction action(std::size_t turn) const {
+      return static_cast<PlayerAction>(turns_[turn] & 0x0F);
+    }
+    MoveResult result(std::size_t turn) const {
+      return static_cast<MoveResult>((turns_[turn] >> 4) & 0x0F);
+    }
+
+  private:
+    TaBehavior ta_behavior_ = TaBehavior::Wander;
+    std::string checkpoint_;
+    std::string turns_;
+};
+
+// Takes the actions of an action log, in order; throws if the log runs out or
+// an action isn't valid, which means the game has diverged from the log.
+class ReplayStudentPolicy : public StudentPolicy {
+  public:
+    explicit ReplayStudentPolicy(const ActionLog& log): log_(log) {}
+
+    PlayerAction ChooseAction(Maze& maze,
+        const std::vector<PlayerAction>& valid_actions) override;
+
+  private:
+    const ActionLog& log_;
+    std::size_t turn_ = 0;
+};
+
+unsigned long ReplayActionLog(Maze& maze, const ActionLog& log);
+
+
+#endif //ESCAPEFROMCS162_ACTIONLOG_H
@@ -0,0 +1,515 @@
+/*********************************************************************
+** Program Filename: Benchmarks.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Microbenchmark suite for the game's hot paths, run on
+ * generated mazes from 19x19 up to 4096x4096 (and, for pathfinding, on
+ * generated mazes of open rooms). Reports the time and heap allocations per
+ * operation, and can write the results as JSON so runs of different builds
+ * can be diffed.
+ * Usage: Benchmarks [--json FILE] [--filter TEXT] [--max-size N]
+ *                   [--min-time SECONDS]
+** Input: None
+** Output: A table of results, and optionally a JSON file.
+*********************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <unistd.h>
+#include "FrameBuilder.h"
+#include "Instrumentation.h"
+#include "Maze.h"
+#include "Pathfinder.h"
+#include "ProceduralMaze.h"
+#include "StudentPolicy.h"
+
+#ifdef ESC162_INSTRUMENT
+// Instrumented builds already replace operator new to count allocations.
+#define allocation_count CounterValue(kCounterAllocations)
+#define allocation_bytes CounterValue(kCounterAllocatedBytes)
+#else
+// Every heap allocation made by the program goes through the operator new
+// below, which counts them; the counts are only read between benchmark runs.
+static unsigned long allocation_count = 0;
+static unsigned long allocation_bytes = 0;
+
+/*********************************************************************
+** Function: operator new
+** Description: Replaces the global operator new to count allocations.
+** Parameters: size is the number of bytes to allocate.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void* operator new(std::size_t size) {
+  ++allocation_count;
+  allocation_bytes += size;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+/*********************************************************************
+** Function: operator delete
+** Description: Replaces the global operator delete to match operator new.
+** Parameters: p is the memory to free.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+/*********************************************************************
+** Function: operator delete
+** Description: Sized version of operator delete.
+** Parameters: p is the memory to free.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+#endif
+
+// Options parsed from the command line.
+struct BenchOptions {
+  std::string json_path;
+  std::string filter;
+  unsigned max_size = 4096;
+  double min_time = 0.2;
+};
+
+struct BenchResult {
+  std::string name;
+  unsigned size;
+  unsigned long iterations;
+  double ns_per_op;
+  double allocs_per_op;
+  double bytes_per_op;
+};
+
+// Discards everything written to it, so rendering can be timed without the
+// cost of a terminal or a file.
+class NullBuffer : public std::streambuf {
+  protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+      return n;
+    }
+};
+
+// Plays a fixed script: on turn n, takes the (n mod k)-th of the k valid
+// actions, so every run makes exactly the same moves.
+class ScriptedStudentPolicy : public StudentPolicy {
+  public:
+    PlayerAction ChooseAction(Maze&,
+        const std::vector<PlayerAction>& valid_actions) override {
+      return valid_actions[turn_++ % valid_actions.size()];
+    }
+
+  private:
+    unsigned long turn_ = 0;
+};
+
+/*********************************************************************
+** Function: RunBench
+** Description: Times op, doubling the number of calls until a batch takes at
+ * least min_time, and records the time and allocations per call of that
+ * batch.
+** Parameters: name is the benchmark's name; size is the maze's side length;
+ * min_time is the minimum batch time in seconds; op performs the i-th
+ * operation.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename F>
+BenchResult RunBench(const std::string& name, unsigned size, double min_time,
+    F op) {
+  unsigned long iterations = 1;
+  unsigned long next_i = 0;
+
+  for (;;) {
+    unsigned long allocs_before = allocation_count;
+    unsigned long bytes_before = allocation_bytes;
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned long n = 0; n != iterations; ++n) op(next_i++);
+
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    if (elapsed.count() >= min_time || iterations >= (1UL << 40)) {
+      return BenchResult{
+          name, size, iterations, elapsed.count() * 1e9 / iterations,
+          static_cast<double>(allocation_count - allocs_before) / iterations,
+          static_cast<double>(allocation_bytes - bytes_before) / iterations};
+    }
+
+    iterations *= 2;
+  }
+}
+
+/*********************************************************************
+** Function: Report
+** Description: Prints a result as a row of the results table and keeps it.
+** Parameters: results collects the results; result is the new result.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void Report(std::vector<BenchResult>& results, const BenchResult& result) {
+  std::cout << std::left << std::setw(26) << result.name << std::right
+            << std::setw(6) << result.size << std::setw(12)
+            << result.iterations << std::fixed << std::setprecision(1)
+            << std::setw(16) << result.ns_per_op << std::setprecision(2)
+            << std::setw(14) << result.allocs_per_op << std::setw(16)
+            << result.bytes_per_op << std::endl;
+  results.push_back(result);
+}
+
+/*********************************************************************
+** Function: OpenPositions
+** Description: Returns the positions of every open space on the level, in
+ * a shuffled order.
+** Parameters: level is the level; rng shuffles the positions.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::vector<MazePosition> OpenPositions(const MazeLevel& level, Rng& rng) {
+  BitPlane open = level.plane(kCellWall);
+  open.Invert();
+
+  std::vector<MazePosition> positions;
+  for (unsigned index : open.SetIndices()) {
+    positions.push_back(level.PositionOf(index));
+  }
+  std::shuffle(positions.begin(), positions.end(), rng);
+  return positions;
+}
+
+/*********************************************************************
+** Function: BenchPathfinders
+** Description: Times shortest-path queries between random pairs of open
+ * spaces with A* and with jump point search.
+** Parameters: suffix is appended to the benchmarks' names; size is the
+ * maze's side length; level is the level to search; open are the level's
+ * open positions, shuffled; opts are the options; results collects the
+ * results.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void BenchPathfinders(const std::string& suffix, unsigned size,
+    const MazeLevel& level, const std::vector<MazePosition>& open,
+    const BenchOptions& opts, std::vector<BenchResult>& results) {
+  auto selected = [&](const std::string& name) {
+      return name.find(opts.filter) != std::string::npos;
+  };
+
+  // Consecutive shuffled positions make pairs a third of the level apart on
+  // average.
+  auto query = [&](Pathfinder& pathfinder, unsigned long i) {
+      i = 2 * i % (open.size() - 1);
+      pathfinder.FindPath(level.IndexOf(open[i]), level.IndexOf(open[i + 1]));
+  };
+
+  if (selected("astar_path" + suffix)) {
+    AStarPathfinder astar(level);
+    Report(results, RunBench("astar_path" + suffix, size, opts.min_time,
+        [&](unsigned long i) {
+            query(astar, i);
+        }));
+  }
+
+  if (selected("jps_path" + suffix)) {
+    JumpPointPathfinder jps(level);
+    Report(results, RunBench("jps_path" + suffix, size, opts.min_time,
+        [&](unsigned long i) {
+            query(jps, i);
+        }));
+  }
+}
+
+/*********************************************************************
+** Function: BenchRoomMaze
+** Description: Runs the benchmarks that depend on a level's layout on a
+ * single-level size x size maze of open rooms.
+** Parameters: size is the maze's side length; opts are the options; results
+ * collects the results.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void BenchRoomMaze(unsigned size, const BenchOptions& opts,
+    std::vector<BenchResult>& results) {
+  const std::uint64_t kSeed = 162;
+
+  ProceduralMazeOptions maze_opts;
+  maze_opts.height = maze_opts.width = size;
+  maze_opts.seed = kSeed;
+  maze_opts.rooms = 0.5;
+  maze_opts.room_size = 32;
+  maze_opts.threads = 1;
+
+  std::string path = WriteTemporaryProceduralMaze(maze_opts);
+  Maze maze(path, 1, kSeed);
+  unlink(path.c_str());
+
+  Rng rng(kSeed);
+  MazeLevel& level = maze.CurrentStudentLevel();
+  BenchPathfinders("_rooms", size, level, OpenPositions(level, rng), opts,
+                   results);
+}
+
+/*********************************************************************
+** Function: BenchMaze
+** Description: Runs every benchmark on a single-level size x size maze.
+** Parameters: size is the maze's side length; opts are the options; results
+ * collects the results.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void BenchMaze(unsigned size, const BenchOptions& opts,
+    std::vector<BenchResult>& results) {
+  const std::uint64_t kSeed = 162;
+
+  auto selected = [&](const std::string& name) {
+      return name.find(opts.filter) != std::string::npos;
+  };
+
+  ProceduralMazeOptions maze_opts;
+  maze_opts.height = maze_opts.width = size;
+  maze_opts.seed = kSeed;
+  maze_opts.threads = 1;
+
+  // Parsing: one level straight from an in-memory copy of the file.
+  std::string text = ProceduralMazeText(maze_opts);
+  const char* body = text.data() + text.find('\n') + 1;
+  if (selected("parse_level")) {
+    Report(results, RunBench("parse_level", size, opts.min_time,
+        [&](unsigned long) {
+            const char* cursor = body;
+            MazeLevel level(cursor, text.data() + text.size(), 0, size, size);
+        }));
+  }
+  text.clear();
+  text.shrink_to_fit();
+
+  std::string path = WriteTemporaryProceduralMaze(maze_opts);
+  Maze maze(path, 1, kSeed);
+  unlink(path.c_str());
+
+  ScriptedStudentPolicy policy;
+  maze.set_student_policy(&policy);
+
+  Rng rng(kSeed);
+  MazeLevel& level = maze.CurrentStudentLevel();
+  std::vector<MazePosition> open = OpenPositions(level, rng);
+
+  if (selected("valid_actions_at")) {
+    Report(results, RunBench("valid_actions_at", size, opts.min_time,
+        [&](unsigned long i) {
+            maze.ValidActionsAt(open[i % open.size()]);
+        }));
+  }
+
+  if (selected("move_people")) {
+    Report(results, RunBench("move_people", size, opts.min_time,
+        [&](unsigned long) {
+            maze.MovePeople();
+        }));
+  }
+
+  // The scripted student moves on most turns, so the chase field is rebuilt
+  // on most of them.
+  if (selected("move_people_chase")) {
+    maze.set_ta_behavior(TaBehavior::Chase);
+    Report(results, RunBench("move_people_chase", size, opts.min_time,
+        [&](unsigned long) {
+            maze.MovePeople();
+        }));
+    maze.set_ta_behavior(TaBehavior::Wander);
+  }
+
+  // Looks at the student's surroundings from many different spaces; the
+  // student is put back where they were afterwards.
+  MazePosition student_pos = maze.student()->position();
+  if (selected("handle_current_position")) {
+    Report(results, RunBench("handle_current_position", size, opts.min_time,
+        [&](unsigned long i) {
+            maze.student()->set_position(open[i % open.size()]);
+            maze.HandleCurrentPosition();
+        }));
+  }
+  maze.student()->set_position(student_pos);
+
+  // The bulk form of the same question: every open cell a TA could catch
+  // the student on, across the whole level.
+  if (selected("cells_near_tas")) {
+    Report(results, RunBench("cells_near_tas", size, opts.min_time,
+        [&](unsigned long) {
+            level.CellsNear(kCellTa);
+        }));
+  }
+
+  std::vector<unsigned> sampled;
+  if (selected("random_empty_spaces")) {
+    Report(results, RunBench("random_empty_spaces", size, opts.min_time,
+        [&](unsigned long) {
+            level.RandomEmptySpaces(3, rng, sampled);
+        }));
+  }
+
+  if (selected("reset_level")) {
+    Report(results, RunBench("reset_level", size, opts.min_time,
+        [&](unsigned long) {
+            maze.ResetLevel(level);
+        }));
+  }
+
+  NullBuffer null_buffer;
+  std::ostream null_stream(&null_buffer);
+  if (selected("render_level")) {
+    Report(results, RunBench("render_level", size, opts.min_time,
+        [&](unsigned long) {
+            null_stream << level;
+        }));
+  }
+
+  std::stringstream checkpoint;
+  if (selected("save_checkpoint")) {
+    Report(results, RunBench("save_checkpoint", size, opts.min_time,
+        [&](unsigned long) {
+            checkpoint.str(std::string());
+            maze.SaveCheckpoint(checkpoint);
+        }));
+  }
+
+  if (selected("load_checkpoint")) {
+    checkpoint.str(std::string());
+    maze.SaveCheckpoint(checkpoint);
+    std::string saved = checkpoint.str();
+    Report(results, RunBench("load_checkpoint", size, opts.min_time,
+        [&](unsigned long) {
+            std::istringstream is(saved);
+            maze.LoadCheckpoint(is);
+        }));
+  }
+
+  // A full search of the level from the start cell, as when a skill field is
+  // recomputed after a pickup.
+  DistanceField field;
+  std::vector<unsigned> sources(1, level.start_index());
+  if (selected("distance_field")) {
+    Report(results, RunBench("distance_field", size, opts.min_time,
+        [&](unsigned long) {
+            field.Compute(level, sources);
+        }));
+  }
+
+  // Shortest paths to the instructor from many different spaces, read from
+  // the level's cached field.
+  level.DistanceFieldTo(DistanceTarget::Instructor);
+  if (selected("path_to_instructor")) {
+    Report(results, RunBench("path_to_instructor", size, opts.min_time,
+        [&](unsigned long i) {
+            level.PathTo(DistanceTarget::Instructor,
+                         level.IndexOf(open[i % open.size()]));
+        }));
+  }
+
+  BenchPathfinders("", size, level, open, opts, results);
+
+  FrameBuilder frame;
+  if (selected("frame_level")) {
+    Report(results, RunBench("frame_level", size, opts.min_time,
+        [&](unsigned long) {
+            frame.Clear();
+            frame.AppendLevel(level);
+        }));
+  }
+}
+
+/*********************************************************************
+** Function: WriteJson
+** Description: Writes the results as JSON.
+** Parameters: os is the stream to write to; results are the results.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void WriteJson(std::ostream& os, const std::vector<BenchResult>& results) {
+  os << "{\n  \"benchmarks\": [\n";
+  for (std::size_t i = 0; i != results.size(); ++i) {
+    const BenchResult& r = results[i];
+    os << "    {\"name\": \"" << r.name << "\", \"size\": " << r.size
+       << ", \"iterations\": " << r.iterations
+       << std::fixed << std::setprecision(3)
+       << ", \"ns_per_op\": " << r.ns_per_op
+       << ", \"allocs_per_op\": " << r.allocs_per_op
+       << ", \"bytes_per_op\": " << r.bytes_per_op << '}'
+       << (i + 1 != results.size() ? "," : "") << '\n';
+  }
+  os << "  ]\n}\n";
+}
+
+/*********************************************************************
+** Function: ParseOptions
+** Description: Parses the command line arguments.
+** Parameters: argc and argv are the arguments given to main.
+** Pre-Conditions: None
+** Post-Conditions: Returns None if the arguments are invalid.
+*********************************************************************/
+Option<BenchOptions> ParseOptions(int argc, char** argv) {
+  BenchOptions opts;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) return None;
+    std::istringstream iss(argv[++i]);
+
+    if (arg == "--json") iss >> opts.json_path;
+    else if (arg == "--filter") iss >> opts.filter;
+    else if (arg == "--max-size") iss >> opts.max_size;
+    else if (arg == "--min-time") iss >> opts.min_time;
+    else return None;
+
+    if (!iss) return None;
+  }
+
+  return opts;
+}
+
+int main(int argc, char** argv) {
+  Option<BenchOptions> parsed = ParseOptions(argc, argv);
+  if (parsed.IsNone()) {
+    std::cerr << "Usage: " << argv[0] << " [--json FILE] [--filter TEXT] "
+              << "[--max-size N] [--min-time SECONDS]\n";
+    return -1;
+  }
+  BenchOptions opts = parsed.Unwrap();
+
+  std::cout << std::left << std::setw(26) << "benchmark" << std::right
+            << std::setw(6) << "size" << std::setw(12) << "iterations"
+            << std::setw(16) << "ns/op" << std::setw(14) << "allocs/op"
+            << std::setw(16) << "bytes/op" << '\n';
+
+  std::vector<BenchResult> results;
+  for (unsigned size : {19u, 64u, 256u, 1024u, 4096u}) {
+    if (size <= opts.max_size) BenchMaze(size, opts, results);
+  }
+  for (unsigned size : {64u, 256u, 1024u, 4096u}) {
+    if (size <= opts.max_size) BenchRoomMaze(size, opts, results);
+  }
+
+  if (!opts.json_path.empty()) {
+    std::ofstream os(opts.json_path);
+    WriteJson(os, results);
+    if (!os) {
+      std::cerr << "Unable to write " << opts.json_path << ".\n";
+      return -1;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,246 @@
+/*********************************************************************
+** Program Filename: BitPlane.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the BitPlane class and in
+ * the BitPlane header. Bulk operations use AVX2 or SSE2 when the compiler
+ * targets them and fall back to plain 64-bit words otherwise.
+** Input: None
+** Output: None
+*********************************************************************/
+#include "BitPlane.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*********************************************************************
+** Function: BitPlane
+** Description: Constructor for the BitPlane class; all bits start cleared.
+** Parameters: height and width are the dimensions of the level.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+BitPlane::BitPlane(unsigned height, unsigned width): height_(height),
+    width_(width), size_(height * width), words_((size_ + 63) / 64, 0) {}
+
+/*********************************************************************
+** Function: BitPlane
+** Description: Constructor for the BitPlane class that takes ownership of
+ * already-packed words (e.g., read from a compiled maze).
+** Parameters: height and width are the dimensions of the level; words holds
+ * at least (height * width + 63) / 64 words in the layout of words().
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+BitPlane::BitPlane(unsigned height, unsigned width,
+    std::vector<std::uint64_t> words): height_(height), width_(width),
+    size_(height * width), words_(std::move(words)) {
+  words_.resize((size_ + 63) / 64);
+  ClearTail();
+}
+
+/*********************************************************************
+** Function: Invert
+** Description: Flips every bit that corresponds to a cell.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void BitPlane::Invert() {
+  for (auto& w : words_) w = ~w;
+  ClearTail();
+}
+
+// Applies an operation word-wise to dst and src, 256 or 128 bits at a time
+// where the target supports it. The vector and scalar forms of each
+// operation are passed separately so every path computes the same thing.
+#if defined(__AVX2__)
+#define ESC162_BITPLANE_BULK_OP(dst, src, n, vec_op, scalar_expr) \
+  do { \
+    std::size_t i_ = 0; \
+    for (; i_ + 4 <= (n); i_ += 4) { \
+      __m256i a_ = _mm256_loadu_si256( \
+          reinterpret_cast<const __m256i*>((dst) + i_)); \
+      __m256i b_ = _mm256_loadu_si256( \
+          reinterpret_cast<const __m256i*>((src) + i_)); \
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>((dst) + i_), \
+          vec_op##256(a_, b_)); \
+    } \
+    for (; i_ != (n); ++i_) { \
+      std::uint64_t& a = (dst)[i_]; \
+      const std::uint64_t b = (src)[i_]; \
+      a = scalar_expr; \
+    } \
+  } while (0)
+#define ESC162_VEC_OR256(a, b) _mm256_or_si256(a, b)
+#define ESC162_VEC_ANDNOT256(a, b) _mm256_andnot_si256(b, a)
+#elif defined(__SSE2__)
+#define ESC162_BITPLANE_BULK_OP(dst, src, n, vec_op, scalar_expr) \
+  do { \
+    std::size_t i_ = 0; \
+    for (; i_ + 2 <= (n); i_ += 2) { \
+      __m128i a_ = _mm_loadu_si128( \
+          reinterpret_cast<const __m128i*>((dst) + i_)); \
+      __m128i b_ = _mm_loadu_si128( \
+          reinterpret_cast<const __m128i*>((src) + i_)); \
+      _mm_storeu_si128(reinterpret_cast<__m128i*>((dst) + i_), \
+          vec_op##128(a_, b_)); \
+    } \
+    for (; i_ != (n); ++i_) { \
+      std::uint64_t& a = (dst)[i_]; \
+      const std::uint64_t b = (src)[i_]; \
+      a = scalar_expr; \
+    } \
+  } while (0)
+#define ESC162_VEC_OR128(a, b) _mm_or_si128(a, b)
+#define ESC162_VEC_ANDNOT128(a, b) _mm_andnot_si128(b, a)
+#else
+#define ESC162_BITPLANE_BULK_OP(dst, src, n, vec_op, scalar_expr) \
+  do { \
+    for (std::size_t i_ = 0; i_ != (n); ++i_) { \
+      std::uint64_t& a = (dst)[i_]; \
+      const std::uint64_t b = (src)[i_]; \
+      a = scalar_expr; \
+    } \
+  } while (0)
+#endif
+
+/*********************************************************************
+** Function: Or
+** Description: Unions this plane with rhs.
+** Parameters: rhs is a plane of the same dimensions.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void BitPlane::Or(const BitPlane& rhs) {
+  ESC162_BITPLANE_BULK_OP(words_.data(), rhs.words_.data(), words_.size(),
+                          ESC162_VEC_OR, a | b);
+}
+
+/*********************************************************************
+** Function: AndNot
+** Description: Clears every bit of this plane that is set in rhs.
+** Parameters: rhs is a plane of the same dimensions.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void BitPlane::AndNot(const BitPlane& rhs) {
+  ESC162_BITPLANE_BULK_OP(words_.data(), rhs.words_.data(), words_.size(),
+                          ESC162_VEC_ANDNOT, a & ~b);
+}
+
+#undef ESC162_BITPLANE_BULK_OP
+
+/*********************************************************************
+** Function: Dilated
+** Description: Returns a plane with every set cell and its four orthogonal
+ * neighbors set; e.g., dilating the TA plane gives every cell at or next to
+ * a TA.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+BitPlane BitPlane::Dilated() const {
+  BitPlane out = *this;
+  if (size_ == 0) return out;
+
+  // Shifting by one moves cells in the last column onto the first column of
+  // the next row (and vice versa), so those bits are masked off.
+  BitPlane right = Shifted(1);
+  right.AndNot(ColumnMask(0));
+  BitPlane left = Shifted(-1);
+  left.AndNot(ColumnMask(width_ - 1));
+
+  out.Or(right);
+  out.Or(left);
+  out.Or(Shifted(width_));
+  out.Or(Shifted(-static_cast<long>(width_)));
+  return out;
+}
+
+/*********************************************************************
+** Function: SetIndices
+** Description: Returns the index of every set bit, in increasing order.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::vector<unsigned> BitPlane::SetIndices() const {
+  std::vector<unsigned> indices;
+
+  for (std::size_t k = 0; k != words_.size(); ++k) {
+    std::uint64_t w = words_[k];
+    while (w != 0) {
+      indices.push_back(static_cast<unsigned>(k * 64 + __builtin_ctzll(w)));
+      w &= w - 1;
+    }
+  }
+
+  return indices;
+}
+
+/*********************************************************************
+** Function: ClearTail
+** Description: Clears the bits of the last word that are past the final
+ * cell.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void BitPlane::ClearTail() {
+  unsigned used = size_ & 63;
+  if (used != 0 && !words_.empty())
+    words_.back() &= (std::uint64_t(1) << used) - 1;
+}
+
+/*********************************************************************
+** Function: Shifted
+** Description: Returns a copy of the plane with every bit moved from index
+ * i to index i + amount; bits shifted past either end are dropped.
+** Parameters: amount is the (possibly negative) number of bits to shift.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+BitPlane BitPlane::Shifted(long amount) const {
+  BitPlane out(height_, width_);
+  const long n = static_cast<long>(words_.size());
+  const long word_shift = (amount < 0 ? -amount : amount) / 64;
+  const unsigned bit_shift = (amount < 0 ? -amount : amount) % 64;
+
+  for (long k = 0; k != n; ++k) {
+    std::uint64_t w = 0;
+
+    if (amount >= 0) {
+      long src = k - word_shift;
+      if (src >= 0) w = words_[src] << bit_shift;
+      if (bit_shift != 0 && src - 1 >= 0)
+        w |= words_[src - 1] >> (64 - bit_shift);
+    } else {
+      long src = k + word_shift;
+      if (src < n) w = words_[src] >> bit_shift;
+      if (bit_shift != 0 && src + 1 < n)
+        w |= words_[src + 1] << (64 - bit_shift);
+    }
+
+    out.words_[k] = w;
+  }
+
+  out.ClearTail();
+  return out;
+}
+
+/*********************************************************************
+** Function: ColumnMask
+** Description: Returns a plane with every cell in the given column set.
+** Parameters: col is the column to set.
+** Pre-Conditions: col < width
+** Post-Conditions: None
+*********************************************************************/
+BitPlane BitPlane::ColumnMask(unsigned col) const {
+  BitPlane mask(height_, width_);
+  for (unsigned row = 0; row != height_; ++row) mask.Set(row * width_ + col);
+  return mask;
+}
@@ -0,0 +1,62 @@
+#ifndef ESCAPEFROMCS162_BITPLANE_H
+#define ESCAPEFROMCS162_BITPLANE_H
+/*********************************************************************
+** Program Filename: BitPlane.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the BitPlane class and its related members.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstdint>
+#include <vector>
+
+// A BitPlane holds one bit per cell of a level, in the same row-major order
+// as the level's cells (bit i is the cell at row i / width, column i % width).
+// Bits past the last cell are always zero, so whole-word operations never
+// have to special-case the tail.
+class BitPlane {
+  public:
+    BitPlane(): height_(0), width_(0), size_(0) {}
+    BitPlane(unsigned height, unsigned width);
+    BitPlane(unsigned height, unsigned width, std::vector<std::uint64_t> words);
+
+    bool Test(unsigned i) const { return (words_[i >> 6] >> (i & 63)) & 1; }
+    void Set(unsigned i) { words_[i >> 6] |= std::uint64_t(1) << (i & 63); }
+    void Clear(unsigned i) { words_[i >> 6] &= ~(std::uint64_t(1) << (i & 63)); }
+
+    void Assign(unsigned i, bool value) { if (value) Set(i); else Clear(i); }
+
+    void Invert();
+
+    // this = this (op) rhs; rhs must have the same dimensions.
+    void Or(const BitPlane& rhs);
+    void AndNot(const BitPlane& rhs);
+
+    // Returns a plane where every set cell and its four orthogonal neighbors
+    // are set (neighbors never wrap between rows).
+    BitPlane Dilated() const;
+
+    std::vector<unsigned> SetIndices() const;
+
+    unsigned height() const { return height_; }
+    unsigned width() const { return width_; }
+    unsigned size() const { return size_; }
+    const std::vector<std::uint64_t>& words() const { return words_; }
+
+  private:
+    unsigned height_;
+    unsigned width_;
+    unsigned size_;
+
+    std::vector<std::uint64_t> words_;
+
+    void ClearTail();
+    BitPlane Shifted(long amount) const;
+    BitPlane ColumnMask(unsigned col) const;
+};
+
+
+#endif //ESCAPEFROMCS162_BITPLANE_H
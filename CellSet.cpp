@@ -0,0 +1,86 @@
+/*********************************************************************
+** Program Filename: CellSet.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the CellSet class.
+** Input: None
+** Output: None
+*********************************************************************/
+#include "CellSet.h"
+
+/*********************************************************************
+** Function: ShuffleFront
+** Description: Moves count members, chosen uniformly at random without
+ * replacement, to the front of the set (positions 0 through count - 1) in a
+ * random order; this is the first count steps of a Fisher-Yates shuffle.
+** Parameters: count is the number of members to choose; rng is the generator
+ * to choose them with.
+** Pre-Conditions: count <= size()
+** Post-Conditions: None
+*********************************************************************/
+void CellSet::ShuffleFront(unsigned count, Rng& rng) {
+  const unsigned n = size();
+  for (unsigned i = 0; i != count; ++i) {
+    Swap(i, i + static_cast<unsigned>(rng.Below(n - i)));
+  }
+}
+
+/*********************************************************************
+** Function: Swap
+** Description: Swaps the members at two positions.
+** Parameters: i and j are the positions.
+** Pre-Conditions: i and j are less than size().
+** Post-Conditions: None
+*********************************************************************/
+void CellSet::Swap(unsigned i, unsigned j) {
+  Touch(i);
+  Touch(j);
+  std::uint32_t a = members_[i];
+  std::uint32_t b = members_[j];
+  members_[i] = b;
+  members_[j] = a;
+  slot_[a] = j;
+  slot_[b] = i;
+}
+
+/*********************************************************************
+** Function: Commit
+** Description: Remembers the set's current members and their order, for
+ * Restore to return to.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void CellSet::Commit() {
+  committed_ = members_;
+  touched_slots_.clear();
+  slot_touched_.assign(committed_.size(), false);
+}
+
+/*********************************************************************
+** Function: Restore
+** Description: Returns the set to exactly how it was at the last Commit,
+ * visiting only the positions that changed since.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void CellSet::Restore() {
+  // Drop every current member that isn't where it was committed; positions
+  // past the committed size are never tracked, so they're all dropped.
+  for (std::uint32_t slot : touched_slots_) {
+    if (slot < members_.size()) slot_[members_[slot]] = kNone;
+  }
+  for (std::size_t slot = committed_.size(); slot < members_.size(); ++slot) {
+    slot_[members_[slot]] = kNone;
+  }
+
+  members_.resize(committed_.size());
+  for (std::uint32_t slot : touched_slots_) {
+    members_[slot] = committed_[slot];
+    slot_[committed_[slot]] = slot;
+    slot_touched_[slot] = false;
+  }
+
+  touched_slots_.clear();
+}
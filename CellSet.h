@@ -0,0 +1,80 @@
+#ifndef ESCAPEFROMCS162_CELLSET_H
+#define ESCAPEFROMCS162_CELLSET_H
+/*********************************************************************
+** Program Filename: CellSet.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the CellSet class and its related members.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstdint>
+#include <vector>
+#include "Rng.h"
+
+// A set of the cell indices of one level, stored densely so that inserting,
+// erasing, and choosing k random members all take time independent of the
+// level's size (O(1), O(1), and O(k) respectively). The order of the members
+// (which decides what ShuffleFront picks) depends on every change made to the
+// set, so the set can be committed and later restored, members and order
+// alike, in time proportional to the number of changes in between.
+class CellSet {
+  public:
+    CellSet() = default;
+    explicit CellSet(unsigned cells): slot_(cells, kNone) {}
+
+    bool Contains(unsigned cell) const { return slot_[cell] != kNone; }
+    unsigned size() const { return static_cast<unsigned>(members_.size()); }
+    bool empty() const { return members_.empty(); }
+    // Members are in no particular order, which changes as the set does.
+    unsigned operator[](unsigned i) const { return members_[i]; }
+
+    // The cell must not already be in the set.
+    void Insert(unsigned cell) {
+      Touch(members_.size());
+      slot_[cell] = static_cast<std::uint32_t>(members_.size());
+      members_.push_back(cell);
+    }
+    // The cell must be in the set.
+    void Erase(unsigned cell) {
+      Touch(slot_[cell]);
+      Touch(members_.size() - 1);
+      std::uint32_t last = members_.back();
+      members_[slot_[cell]] = last;
+      slot_[last] = slot_[cell];
+      members_.pop_back();
+      slot_[cell] = kNone;
+    }
+
+    void ShuffleFront(unsigned count, Rng& rng);
+
+    void Commit();
+    void Restore();
+
+  private:
+    static const std::uint32_t kNone = UINT32_MAX;
+
+    // members_ lists the cells in the set; slot_[cell] is the cell's position
+    // in members_ (kNone if it isn't in the set).
+    std::vector<std::uint32_t> members_;
+    std::vector<std::uint32_t> slot_;
+
+    // members_ as of the last Commit, and the positions of members_ (below
+    // committed_.size()) changed since then, each listed once.
+    std::vector<std::uint32_t> committed_;
+    std::vector<std::uint32_t> touched_slots_;
+    std::vector<bool> slot_touched_;
+
+    void Touch(std::size_t slot) {
+      if (slot < committed_.size() && !slot_touched_[slot]) {
+        slot_touched_[slot] = true;
+        touched_slots_.push_back(static_cast<std::uint32_t>(slot));
+      }
+    }
+    void Swap(unsigned i, unsigned j);
+};
+
+
+#endif //ESCAPEFROMCS162_CELLSET_H
@@ -0,0 +1,64 @@
+/*********************************************************************
+** Program Filename: Checkpoint.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared in the Checkpoint header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <iterator>
+#include "Checkpoint.h"
+
+/*********************************************************************
+** Function: Fnv1a
+** Description: Continues a 64-bit FNV-1a hash over the given bytes.
+** Parameters: hash is the hash so far (kFnv1aOffsetBasis to start one); data
+ * points to the bytes; size is how many there are.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::uint64_t Fnv1a(std::uint64_t hash, const void* data, std::size_t size) {
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i != size; ++i) {
+    hash ^= p[i];
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+/*********************************************************************
+** Function: WriteTo
+** Description: Writes the checkpoint built so far in one call.
+** Parameters: os is the stream to write to.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void CheckpointWriter::WriteTo(std::ostream& os) const {
+  os.write(bytes_.data(), static_cast<std::streamsize>(bytes_.size()));
+}
+
+/*********************************************************************
+** Function: CheckpointReader
+** Description: Constructor for the CheckpointReader class; reads the whole
+ * stream into memory.
+** Parameters: is is the stream to read the checkpoint from.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+CheckpointReader::CheckpointReader(std::istream& is):
+    bytes_(std::istreambuf_iterator<char>(is),
+           std::istreambuf_iterator<char>()) {}
+
+/*********************************************************************
+** Function: GetBytes
+** Description: Returns the next n bytes of the checkpoint.
+** Parameters: n is the number of bytes to read.
+** Pre-Conditions: None
+** Post-Conditions: Throws if fewer than n bytes are left.
+*********************************************************************/
+const char* CheckpointReader::GetBytes(std::size_t n) {
+  Require(n);
+  const char* p = bytes_.data() + pos_;
+  pos_ += n;
+  return p;
+}
@@ -0,0 +1,100 @@
+#ifndef ESCAPEFROMCS162_CHECKPOINT_H
+#define ESCAPEFROMCS162_CHECKPOINT_H
+/*********************************************************************
+** Program Filename: Checkpoint.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the checkpoint format for saved games, and classes
+ * for writing and reading it.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "Rng.h"
+
+// A checkpoint holds only a game's mutable state; the maze itself is
+// identified by Maze::LayoutHash(), so a checkpoint is a few hundred bytes per
+// level however large the levels are. All integers are little-endian:
+//
+//   char     magic[8]              "ESCCKPT\0"
+//   uint32   version               kCheckpointVersion
+//   uint64   layout_hash           Maze::LayoutHash() of the saved maze
+//   uint64   seed                  the maze's master seed
+//   uint32   levels
+//   uint32   student_level, student_row, student_col, student_skills
+//
+// followed by one record per level:
+//
+//   uint64   rng[4]                the level's Rng state
+//   uint32   tas
+//   tas x {  uint32 row, col, appeased_turns; uint64 rng[4]  }
+//   uint32   skills
+//   uint32   skill_cells[skills]   row-major cell indices
+const char kCheckpointMagic[8] = {'E', 'S', 'C', 'C', 'K', 'P', 'T', '\0'};
+const std::uint32_t kCheckpointVersion = 1;
+
+const std::uint64_t kFnv1aOffsetBasis = 0xCBF29CE484222325ULL;
+std::uint64_t Fnv1a(std::uint64_t hash, const void* data, std::size_t size);
+
+// Builds a checkpoint in memory, so it can be written in one call.
+class CheckpointWriter {
+  public:
+    template <typename T>
+    void Put(T value) {
+      for (std::size_t i = 0; i != sizeof(T); ++i)
+        bytes_ += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    void PutBytes(const char* bytes, std::size_t n) { bytes_.append(bytes, n); }
+    void PutRng(const Rng& rng) {
+      for (std::uint64_t word : rng.state()) Put(word);
+    }
+
+    void WriteTo(std::ostream& os) const;
+
+  private:
+    std::string bytes_;
+};
+
+// Reads a checkpoint from memory; every read throws if it would run past the
+// end.
+class CheckpointReader {
+  public:
+    explicit CheckpointReader(std::istream& is);
+
+    template <typename T>
+    T Get() {
+      Require(sizeof(T));
+      T value = 0;
+      for (std::size_t i = 0; i != sizeof(T); ++i)
+        value |= static_cast<T>(static_cast<unsigned char>(bytes_[pos_ + i]))
+                 << (8 * i);
+      pos_ += sizeof(T);
+      return value;
+    }
+    const char* GetBytes(std::size_t n);
+    Rng GetRng() {
+      Rng::State state;
+      for (auto& word : state) word = Get<std::uint64_t>();
+      return Rng::FromState(state);
+    }
+
+    bool AtEnd() const { return pos_ == bytes_.size(); }
+
+  private:
+    std::string bytes_;
+    std::size_t pos_ = 0;
+
+    void Require(std::size_t n) const {
+      if (bytes_.size() - pos_ < n)
+        throw std::runtime_error("Checkpoint is truncated.");
+    }
+};
+
+
+#endif //ESCAPEFROMCS162_CHECKPOINT_H
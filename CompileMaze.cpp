@@ -0,0 +1,46 @@
+/*********************************************************************
+** Program Filename: CompileMaze.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Application file for the maze compiler, which validates a
+ * maze data file and writes it as a compiled (.mazeb) maze that loads
+ * without any text parsing.
+ * Usage: CompileMaze MAZE_FILE OUTPUT_FILE
+** Input: Path to a maze data file.
+** Output: The compiled maze.
+*********************************************************************/
+#include <fstream>
+#include <iostream>
+#include "Maze.h"
+#include "MazeBinary.h"
+#include "Parallel.h"
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " MAZE_FILE OUTPUT_FILE\n";
+    return -1;
+  }
+
+  try {
+    // Building the Maze runs every check the game itself runs, so only valid
+    // mazes are ever compiled.
+    Maze maze(argv[1], DefaultThreadCount());
+
+    std::ofstream os(argv[2], std::ios::binary);
+    if (!os) {
+      std::cerr << "Unable to open " << argv[2] << " for writing.\n";
+      return -1;
+    }
+
+    WriteMazeBinary(os, maze.levels());
+    if (!os) {
+      std::cerr << "Failed to write " << argv[2] << ".\n";
+      return -1;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << argv[1] << ": " << e.what() << '\n';
+    return -1;
+  }
+
+  return 0;
+}
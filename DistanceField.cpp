@@ -0,0 +1,96 @@
+/*********************************************************************
+** Program Filename: DistanceField.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the DistanceField class.
+** Input: None
+** Output: None
+*********************************************************************/
+#include "DistanceField.h"
+#include "MazeLevel.h"
+
+const std::uint32_t DistanceField::kUnreachable;
+
+/*********************************************************************
+** Function: Compute
+** Description: Finds the distance from every cell of the level to the nearest
+ * source, moving the way the student does.
+** Parameters: level is the level; sources are the indices of the open cells
+ * to measure distances to.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void DistanceField::Compute(const MazeLevel& level,
+    const std::vector<unsigned>& sources) {
+  distances_.assign(static_cast<std::size_t>(level.height()) * level.width(),
+                    kUnreachable);
+  queue_.clear();
+
+  for (unsigned source : sources) {
+    if (distances_[source] == kUnreachable) {
+      distances_[source] = 0;
+      queue_.push_back(source);
+    }
+  }
+
+  for (std::size_t head = 0; head != queue_.size(); ++head) {
+    unsigned index = queue_[head];
+    std::uint32_t next = distances_[index] + 1;
+
+    for (unsigned mask = level.MoveMaskAt(index); mask != 0;
+         mask &= mask - 1) {
+      auto dir = static_cast<PlayerDirectionAction>(__builtin_ctz(mask));
+      unsigned neighbor = level.NeighborIndex(index, dir);
+      if (distances_[neighbor] == kUnreachable) {
+        distances_[neighbor] = next;
+        queue_.push_back(neighbor);
+      }
+    }
+  }
+}
+
+/*********************************************************************
+** Function: NextStep
+** Description: Returns the first move of a shortest path from a cell to the
+ * nearest source; ties go to the first direction in declaration order.
+** Parameters: level is the level the field was computed on; index is the
+ * cell's index.
+** Pre-Conditions: None
+** Post-Conditions: Returns None if the cell is a source or can't reach one.
+*********************************************************************/
+Option<PlayerDirectionAction> DistanceField::NextStep(const MazeLevel& level,
+    unsigned index) const {
+  std::uint32_t distance = distances_[index];
+  if (distance == 0 || distance == kUnreachable) return None;
+
+  for (unsigned mask = level.MoveMaskAt(index); mask != 0; mask &= mask - 1) {
+    auto dir = static_cast<PlayerDirectionAction>(__builtin_ctz(mask));
+    if (distances_[level.NeighborIndex(index, dir)] == distance - 1) return dir;
+  }
+  return None;
+}
+
+/*********************************************************************
+** Function: PathFrom
+** Description: Returns a shortest path from a cell to the nearest source.
+** Parameters: level is the level the field was computed on; index is the
+ * cell's index.
+** Pre-Conditions: None
+** Post-Conditions: Returns the indices of every cell on the path, from index
+ * to the source inclusive, or None if the cell can't reach a source.
+*********************************************************************/
+Option<std::vector<unsigned>> DistanceField::PathFrom(const MazeLevel& level,
+    unsigned index) const {
+  if (distances_[index] == kUnreachable) return None;
+
+  std::vector<unsigned> path;
+  path.reserve(distances_[index] + 1);
+  path.push_back(index);
+
+  for (Option<PlayerDirectionAction> step = NextStep(level, index);
+       step.IsSome(); step = NextStep(level, index)) {
+    index = level.NeighborIndex(index, step.Unwrap());
+    path.push_back(index);
+  }
+  return path;
+}
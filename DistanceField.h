@@ -0,0 +1,59 @@
+#ifndef ESCAPEFROMCS162_DISTANCEFIELD_H
+#define ESCAPEFROMCS162_DISTANCEFIELD_H
+/*********************************************************************
+** Program Filename: DistanceField.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the DistanceField class and its related members.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstdint>
+#include <vector>
+#include "Option.h"
+#include "PlayerAction.h"
+
+class MazeLevel;
+
+// The things on a level that MazeLevel keeps a DistanceField to.
+enum class DistanceTarget {
+    Ladder,
+    Instructor,
+    Skill,
+};
+
+// Number of DistanceTarget values.
+const unsigned kNumDistanceTargets = 3;
+
+// The number of moves from every cell of a level to the nearest of a set of
+// source cells, found with one breadth-first search from all of the sources
+// at once. Distances are stored in the level's row-major cell order, so a
+// query is a single array lookup, and following a path is a lookup per step.
+class DistanceField {
+  public:
+    static const std::uint32_t kUnreachable = UINT32_MAX;
+
+    void Compute(const MazeLevel& level, const std::vector<unsigned>& sources);
+
+    // kUnreachable for walls and for cells with no path to any source.
+    std::uint32_t operator[](unsigned index) const { return distances_[index]; }
+    Option<unsigned> Distance(unsigned index) const {
+      if (distances_[index] == kUnreachable) return None;
+      return distances_[index];
+    }
+
+    Option<PlayerDirectionAction> NextStep(const MazeLevel& level,
+        unsigned index) const;
+    Option<std::vector<unsigned>> PathFrom(const MazeLevel& level,
+        unsigned index) const;
+
+  private:
+    std::vector<std::uint32_t> distances_;
+    // The search's frontier; kept so recomputing doesn't allocate.
+    std::vector<unsigned> queue_;
+};
+
+
+#endif //ESCAPEFROMCS162_DISTANCEFIELD_H
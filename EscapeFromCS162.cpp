@@ -3,12 +3,24 @@
 ** Author: Jason Chen
 ** Date: 03/19/2018
 ** Description: Application file for the Escape from CS 162 game.
-** Input: Path to maze data file.
+** Input: Path to maze data file, optionally followed by a seed and by
+ * --checkpoint FILE, which resumes the game saved in FILE (if it exists) and
+ * saves the game to it at the start of every turn, and by --record FILE,
+ * which records the game's actions to FILE for SimulateCS162 --replay, and
+ * by --tas chase, which makes unappeased TAs chase the student (a resumed
+ * game should be given the same --tas as it was started with).
 ** Output: None
 *********************************************************************/
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include "ActionLog.h"
+#include "Instrumentation.h"
 #include "Maze.h"
+#include "Parallel.h"
+#include "TerminalRenderer.h"
 
 /*********************************************************************
 ** Function: PromptToContinue
@@ -22,45 +34,97 @@ void PromptToContinue() {
   std::cin.ignore();
 }
 
+/*********************************************************************
+** Function: SaveGame
+** Description: Saves the game to a checkpoint file, replacing it atomically so
+ * an interrupted save never leaves a damaged checkpoint behind.
+** Parameters: maze is the game's maze; path is the checkpoint file's path.
+** Pre-Conditions: None
+** Post-Conditions: Throws if the checkpoint can't be written.
+*********************************************************************/
+void SaveGame(Maze& maze, const std::string& path) {
+  std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream os(tmp_path, std::ios::binary);
+    maze.SaveCheckpoint(os);
+    if (!os) throw std::runtime_error("Unable to write " + tmp_path + ".");
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    throw std::runtime_error("Unable to replace " + path + ".");
+}
+
 /*********************************************************************
 ** Function: InitGameLoop
 ** Description: Starts the game loop, running until the player passes CS 162.
-** Parameters: maze is the game's maze.
+** Parameters: maze is the game's maze; ansi is whether to redraw the maze in
+ * place on an ANSI terminal instead of printing it again every turn;
+ * checkpoint_path is where to save the game every turn (if not empty);
+ * action_log records every turn (if not null).
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-void InitGameLoop(Maze& maze) {
+void InitGameLoop(Maze& maze, bool ansi, const std::string& checkpoint_path,
+    ActionLogWriter* action_log) {
+  TerminalRenderer renderer;
+
   for (;;) {
-    maze.PrintState();
-    maze.MovePeople();
+    ESC162_INSTRUMENT_POLL();
+    ESC162_TIME_PHASE(kPhaseTurn);
+
+    if (!checkpoint_path.empty()) SaveGame(maze, checkpoint_path);
+
+    if (ansi) renderer.Render(maze, std::cout);
+    else maze.PrintState();
+    PlayerAction action = maze.MovePeople();
+
+    // Anything printed under the frame may scroll the screen, so each
+    // message below makes the next frame redraw everything.
+    if (action == PlayerAction::ClimbUp) {
+      std::cout << "\nYou have climbed up to level "
+                << (maze.student()->position().level + 1) << ".\n";
+      renderer.Invalidate();
+    } else if (action == PlayerAction::DemonstrateSkill) {
+      std::cout << "\nYou demonstrated a skill to the TAs; you now have "
+                << maze.student()->prog_skills() << " skills remaining.\n";
+      renderer.Invalidate();
+    }
+
     MoveResult result = maze.HandleCurrentPosition();
+    if (action_log != nullptr) action_log->Record(action, result);
 
     switch (result) {
       case MoveResult::AcquiredSkill:
         std::cout << "\nYou have acquired a skill! You now have "
                   << maze.student()->prog_skills() << " programming skills!\n";
+        renderer.Invalidate();
         break;
       case MoveResult::CaughtByTA:
         std::cout << "\nYou have been caught by an unappeased TA! They sent you"
                   << " back to the start of your current level.\n";
         maze.ResetCurrentLevel();
         PromptToContinue();
+        renderer.Invalidate();
         break;
       case MoveResult::FailedByInstructor:
         std::cout << "\nYou have been failed by the instructor! They sent you "
                   << "all the way back to the beginning.\n";
         maze.ResetAllLevels();
         PromptToContinue();
+        renderer.Invalidate();
         break;
       case MoveResult::SatisfiedInstructor:
         std::cout << "\nCONGRATULATIONS! You have satisfied the instructor and "
                   << "passed CS 162!\n";
+        // A finished game has nothing left to resume.
+        if (!checkpoint_path.empty()) std::remove(checkpoint_path.c_str());
         return;
       case MoveResult::NoEvent:
         break;
     }
 
-    std::cout << "\n\n\n==============================\n\n\n" << std::endl;
+    if (!ansi)
+      std::cout << "\n\n\n==============================\n\n\n" << std::endl;
   }
 };
 
@@ -70,20 +134,77 @@ int main(int argc, char** argv) {
     return -1;
   }
 
-  std::ifstream is(argv[1]);
-  if (!is) {
+  if (!std::ifstream(argv[1])) {
     std::cerr << "Unable to open stream to given maze data file.\n";
     return -1;
   }
 
-  Maze maze(is);
+  // An optional seed replays the exact same game.
+  std::uint64_t seed = RandomSeed();
+  std::string checkpoint_path;
+  std::string record_path;
+  TaBehavior ta_behavior = TaBehavior::Wander;
+  for (int i = 2; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--checkpoint" && i + 1 < argc) {
+      checkpoint_path = argv[++i];
+      continue;
+    }
+    if (arg == "--record" && i + 1 < argc) {
+      record_path = argv[++i];
+      continue;
+    }
+    if (arg == "--tas" && i + 1 < argc &&
+        TaBehaviorNamed(argv[i + 1]).IsSome()) {
+      ta_behavior = TaBehaviorNamed(argv[++i]).Unwrap();
+      continue;
+    }
+
+    std::istringstream iss(arg);
+    if (!StreamGetT(iss, seed)) {
+      std::cerr << "Usage: " << argv[0]
+                << " MAZE_FILE [SEED] [--checkpoint FILE] [--record FILE]"
+                << " [--tas wander|chase]\n"
+                << "The seed must be a non-negative integer.\n";
+      return -1;
+    }
+  }
+
+  Maze maze(argv[1], DefaultThreadCount(), seed);
+  maze.set_ta_behavior(ta_behavior);
+
+  if (!checkpoint_path.empty()) {
+    std::ifstream is(checkpoint_path, std::ios::binary);
+    if (is) {
+      try {
+        maze.LoadCheckpoint(is);
+      } catch (const std::exception& e) {
+        std::cerr << "Unable to resume from " << checkpoint_path << ": "
+                  << e.what() << '\n';
+        return -1;
+      }
+      std::cout << "Resuming the game saved in " << checkpoint_path << ".\n";
+    }
+  }
+
+  // The log starts from the state the game is about to be played from,
+  // whether new or resumed.
+  std::unique_ptr<ActionLogWriter> action_log;
+  if (!record_path.empty()) {
+    try {
+      action_log.reset(new ActionLogWriter(record_path, maze));
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << '\n';
+      return -1;
+    }
+  }
 
   std::cout << "Welcome to Escape from CS 162!\n"
             << "Hit enter to start the game...";
   std::cin.ignore();
   std::cout << "\n\n\n";
 
-  InitGameLoop(maze);
+  InitGameLoop(maze, IsAnsiTerminal(), checkpoint_path, action_log.get());
 
   std::cout << "Thanks for playing Escape from CS 162!\n";
 
@@ -0,0 +1,47 @@
+/*********************************************************************
+** Program Filename: FlowField.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the FlowField class.
+** Input: None
+** Output: None
+*********************************************************************/
+#include "FlowField.h"
+#include "MazeLevel.h"
+
+const std::uint8_t FlowField::kAtTarget;
+const std::uint8_t FlowField::kUnvisited;
+
+/*********************************************************************
+** Function: Compute
+** Description: Finds the first move toward the target from every cell of the
+ * level, moving the way people do.
+** Parameters: level is the level; target is the index of an open cell.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void FlowField::Compute(const MazeLevel& level, unsigned target) {
+  steps_.assign(static_cast<std::size_t>(level.height()) * level.width(),
+                kUnvisited);
+  queue_.clear();
+
+  steps_[target] = kAtTarget;
+  queue_.push_back(target);
+
+  for (std::size_t head = 0; head != queue_.size(); ++head) {
+    unsigned index = queue_[head];
+
+    for (unsigned mask = level.MoveMaskAt(index); mask != 0;
+         mask &= mask - 1) {
+      unsigned dir = __builtin_ctz(mask);
+      unsigned neighbor =
+          level.NeighborIndex(index, static_cast<PlayerDirectionAction>(dir));
+      if (steps_[neighbor] == kUnvisited) {
+        // Directions come in opposite pairs (Up and Down, Left and Right),
+        // so flipping the low bit gives the move back to index.
+        steps_[neighbor] = static_cast<std::uint8_t>(dir ^ 1);
+        queue_.push_back(neighbor);
+      }
+    }
+  }
+}
@@ -0,0 +1,45 @@
+#ifndef ESCAPEFROMCS162_FLOWFIELD_H
+#define ESCAPEFROMCS162_FLOWFIELD_H
+/*********************************************************************
+** Program Filename: FlowField.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the FlowField class and its related members.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstdint>
+#include <vector>
+#include "Option.h"
+#include "PlayerAction.h"
+
+class MazeLevel;
+
+// The first move of a shortest path to one target cell from every cell of a
+// level, found with a single breadth-first search from the target: each cell
+// records the move back toward the cell it was discovered from. However many
+// people follow the field, each of their moves is one table lookup.
+class FlowField {
+  public:
+    void Compute(const MazeLevel& level, unsigned target);
+
+    // None at the target, at walls, and at cells with no path to the target.
+    Option<PlayerDirectionAction> StepFrom(unsigned index) const {
+      if (steps_[index] >= kNumPlayerDirections) return None;
+      return static_cast<PlayerDirectionAction>(steps_[index]);
+    }
+
+  private:
+    // A direction, or one of these for cells without a step.
+    static const std::uint8_t kAtTarget = kNumPlayerDirections;
+    static const std::uint8_t kUnvisited = UINT8_MAX;
+
+    std::vector<std::uint8_t> steps_;
+    // The search's frontier; kept so recomputing doesn't allocate.
+    std::vector<unsigned> queue_;
+};
+
+
+#endif //ESCAPEFROMCS162_FLOWFIELD_H
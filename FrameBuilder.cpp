@@ -0,0 +1,165 @@
+/*********************************************************************
+** Program Filename: FrameBuilder.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the FrameBuilder class.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include "FrameBuilder.h"
+
+/*********************************************************************
+** Function: Reserve
+** Description: Makes room for a frame of the given size, so composing it
+ * doesn't have to grow the buffer.
+** Parameters: size is the expected size of the whole frame in bytes.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void FrameBuilder::Reserve(std::size_t size) {
+  if (buffer_.size() < size) buffer_.resize(size);
+}
+
+/*********************************************************************
+** Function: Extend
+** Description: Grows the frame by n bytes and returns where they start.
+** Parameters: n is the number of bytes to add.
+** Pre-Conditions: None
+** Post-Conditions: The new bytes are uninitialized; the pointer is valid until
+ * the frame grows again.
+*********************************************************************/
+char* FrameBuilder::Extend(std::size_t n) {
+  if (buffer_.size() - size_ < n) {
+    std::size_t doubled = buffer_.size() * 2;
+    buffer_.resize(doubled > size_ + n ? doubled : size_ + n);
+  }
+
+  char* p = buffer_.data() + size_;
+  size_ += n;
+  return p;
+}
+
+/*********************************************************************
+** Function: Append
+** Description: Appends bytes to the frame.
+** Parameters: bytes points to the bytes; n is how many there are.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void FrameBuilder::Append(const char* bytes, std::size_t n) {
+  if (n != 0) memcpy(Extend(n), bytes, n);
+}
+
+/*********************************************************************
+** Function: Append
+** Description: Appends a single character to the frame.
+** Parameters: c is the character.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void FrameBuilder::Append(char c) {
+  *Extend(1) = c;
+}
+
+/*********************************************************************
+** Function: AppendLevel
+** Description: Appends the map of a level, one line per row, growing the
+ * frame once for the whole grid.
+** Parameters: level is the level to append.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void FrameBuilder::AppendLevel(const MazeLevel& level) {
+  AppendLevelWindow(level, 0, 0, level.height(), level.width());
+}
+
+/*********************************************************************
+** Function: AppendLevelWindow
+** Description: Appends a rectangle of a level's map, one line per row,
+ * growing the frame once for the whole rectangle.
+** Parameters: level is the level to append; top and left are the first row
+ * and column to append; rows and cols are how many of each.
+** Pre-Conditions: The rectangle lies within the level.
+** Post-Conditions: None
+*********************************************************************/
+void FrameBuilder::AppendLevelWindow(const MazeLevel& level, unsigned top,
+    unsigned left, unsigned rows, unsigned cols) {
+  const unsigned width = level.width();
+  const MazeCell* cell =
+      level.cells() + static_cast<std::size_t>(top) * width + left;
+  char* out = Extend(static_cast<std::size_t>(rows) * (cols + 1));
+
+  for (unsigned i = 0; i != rows; ++i) {
+    for (unsigned j = 0; j != cols; ++j) {
+      out[j] = kCellDisplayCharacters[cell[j]];
+    }
+    out[cols] = '\n';
+    out += cols + 1;
+    cell += width;
+  }
+}
+
+/*********************************************************************
+** Function: WriteTo
+** Description: Writes the frame to a file descriptor with a single write(2),
+ * repeating it only if the kernel takes part of the frame at a time.
+** Parameters: fd is the file descriptor to write to.
+** Pre-Conditions: Anything buffered for fd elsewhere (e.g. in std::cout) has
+ * been flushed.
+** Post-Conditions: Throws if the write fails.
+*********************************************************************/
+void FrameBuilder::WriteTo(int fd) const {
+  const char* p = buffer_.data();
+  std::size_t left = size_;
+
+  while (left != 0) {
+    ssize_t n = write(fd, p, left);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error(std::string("Unable to write frame: ") +
+                               std::strerror(errno));
+    }
+    p += n;
+    left -= static_cast<std::size_t>(n);
+  }
+}
+
+/*********************************************************************
+** Function: WriteTo
+** Description: Writes the frame to a stream in one call; file streams pass a
+ * write this large straight through to write(2).
+** Parameters: os is the stream to write to.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void FrameBuilder::WriteTo(std::ostream& os) const {
+  os.write(buffer_.data(), static_cast<std::streamsize>(size_));
+}
+
+/*********************************************************************
+** Function: overflow
+** Description: Appends a character written through stream().
+** Parameters: c is the character, or EOF.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+int FrameBuilder::overflow(int c) {
+  if (c != traits_type::eof()) Append(static_cast<char>(c));
+  return traits_type::not_eof(c);
+}
+
+/*********************************************************************
+** Function: xsputn
+** Description: Appends characters written through stream().
+** Parameters: s points to the characters; n is how many there are.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::streamsize FrameBuilder::xsputn(const char* s, std::streamsize n) {
+  Append(s, static_cast<std::size_t>(n));
+  return n;
+}
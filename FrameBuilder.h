@@ -0,0 +1,64 @@
+#ifndef ESCAPEFROMCS162_FRAMEBUILDER_H
+#define ESCAPEFROMCS162_FRAMEBUILDER_H
+/*********************************************************************
+** Program Filename: FrameBuilder.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the FrameBuilder class, which composes a frame of
+ * output in memory so it can be written all at once.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+#include "MazeLevel.h"
+
+// A growable byte buffer for composing a frame: a level is translated into it
+// a whole grid at a time through kCellDisplayCharacters, and anything else
+// (such as Maze::PrintStatus) can be formatted into it through stream(). The
+// buffer keeps its capacity across Clear(), so a builder that is reused
+// stops allocating once it has held its largest frame.
+class FrameBuilder : private std::streambuf {
+  public:
+    FrameBuilder(): stream_(this) {}
+    FrameBuilder(const FrameBuilder&) = delete;
+    FrameBuilder& operator=(const FrameBuilder&) = delete;
+
+    // Writes into the frame, after anything already in it.
+    std::ostream& stream() { return stream_; }
+
+    void Clear() { size_ = 0; }
+    void Reserve(std::size_t size);
+    void Append(const char* bytes, std::size_t n);
+    void Append(char c);
+    void AppendLevel(const MazeLevel& level);
+    // Appends rows [top, top + rows) of the level, each cut to columns
+    // [left, left + cols).
+    void AppendLevelWindow(const MazeLevel& level, unsigned top, unsigned left,
+        unsigned rows, unsigned cols);
+
+    const char* data() const { return buffer_.data(); }
+    std::size_t size() const { return size_; }
+
+    void WriteTo(int fd) const;
+    void WriteTo(std::ostream& os) const;
+
+    static std::size_t LevelSize(const MazeLevel& level) {
+      return static_cast<std::size_t>(level.height()) * (level.width() + 1);
+    }
+
+  private:
+    std::vector<char> buffer_;
+    std::size_t size_ = 0;
+    std::ostream stream_;
+
+    char* Extend(std::size_t n);
+    int overflow(int c) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+};
+
+
+#endif //ESCAPEFROMCS162_FRAMEBUILDER_H
@@ -0,0 +1,99 @@
+/*********************************************************************
+** Program Filename: GenerateMaze.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Application file for the maze generator, which writes a maze
+ * data file of procedurally generated levels (corridors with rooms and
+ * loops, the ladder always reachable from the beginning) of any size,
+ * generating the levels on --threads threads and streaming them to disk.
+ * Usage: GenerateMaze [--levels N] [--height N] [--width N] [--rooms F]
+ *                     [--room-size N] [--loops F] [--seed N] [--threads N]
+ *                     OUTPUT_FILE
+** Input: None
+** Output: The maze data file, and how long it took to write.
+*********************************************************************/
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include "Option.h"
+#include "ProceduralMaze.h"
+
+// Options parsed from the command line.
+struct GenerateOptions {
+  ProceduralMazeOptions maze;
+  std::string output_path;
+};
+
+/*********************************************************************
+** Function: ParseOptions
+** Description: Parses the command line arguments.
+** Parameters: argc and argv are the arguments given to main.
+** Pre-Conditions: None
+** Post-Conditions: Returns None if the arguments are invalid.
+*********************************************************************/
+Option<GenerateOptions> ParseOptions(int argc, char** argv) {
+  GenerateOptions opts;
+  opts.maze.seed = RandomSeed();
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+
+    if (arg == "--levels" || arg == "--height" || arg == "--width" ||
+        arg == "--rooms" || arg == "--room-size" || arg == "--loops" ||
+        arg == "--seed" || arg == "--threads") {
+      if (i + 1 >= argc) return None;
+      std::istringstream iss(argv[++i]);
+
+      if (arg == "--levels") iss >> opts.maze.levels;
+      else if (arg == "--height") iss >> opts.maze.height;
+      else if (arg == "--width") iss >> opts.maze.width;
+      else if (arg == "--rooms") iss >> opts.maze.rooms;
+      else if (arg == "--room-size") iss >> opts.maze.room_size;
+      else if (arg == "--loops") iss >> opts.maze.loops;
+      else if (arg == "--seed") iss >> opts.maze.seed;
+      else iss >> opts.maze.threads;
+
+      if (!iss) return None;
+    } else if (opts.output_path.empty()) {
+      opts.output_path = arg;
+    } else {
+      return None;
+    }
+  }
+
+  if (opts.output_path.empty()) return None;
+  return opts;
+}
+
+int main(int argc, char** argv) {
+  Option<GenerateOptions> parsed = ParseOptions(argc, argv);
+  if (parsed.IsNone()) {
+    std::cerr << "Usage: " << argv[0] << " [--levels N] [--height N] "
+              << "[--width N] [--rooms F] [--room-size N] [--loops F] "
+              << "[--seed N] [--threads N] OUTPUT_FILE\n";
+    return -1;
+  }
+
+  GenerateOptions opts = parsed.Unwrap();
+  auto begin = std::chrono::steady_clock::now();
+  std::uint64_t bytes;
+  try {
+    bytes = WriteProceduralMaze(opts.output_path, opts.maze);
+  } catch (const std::exception& e) {
+    std::cerr << opts.output_path << ": " << e.what() << '\n';
+    return -1;
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - begin;
+  double secs = elapsed.count() > 0 ? elapsed.count() : 1e-9;
+
+  std::cout << opts.output_path << '\n'
+            << "  Levels: " << opts.maze.levels << " of "
+            << opts.maze.height << " x " << opts.maze.width << '\n'
+            << "  Seed: " << opts.maze.seed << '\n'
+            << "  Bytes: " << bytes << '\n'
+            << "  Threads: " << opts.maze.threads << '\n'
+            << "  Elapsed: " << elapsed.count() << " s\n"
+            << "  MB/sec: " << (bytes / secs / 1e6) << '\n';
+  return 0;
+}
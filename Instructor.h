@@ -21,8 +21,8 @@ class Instructor : public MazePerson {
     GetMove(std::vector<PlayerAction>) override { return None; }
 
     // Since the instructor never moves, these methods shouldn't do anything.
-    void Occupy(OpenSpace*) override {}
-    void Unoccupy(OpenSpace*) override {}
+    void Occupy(OpenSpace) override {}
+    void Unoccupy(OpenSpace) override {}
 };
 
 
@@ -0,0 +1,356 @@
+/*********************************************************************
+** Program Filename: Instrumentation.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared in the Instrumentation header;
+ * everything here is compiled only when ESC162_INSTRUMENT is defined.
+** Input: None
+** Output: The instrumentation dump (see the header).
+*********************************************************************/
+#include "Instrumentation.h"
+
+#ifdef ESC162_INSTRUMENT
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <new>
+
+namespace {
+
+const char* const kCounterNames[kNumInstrumentationCounters] = {
+  "space_at", "location_at", "ta_moves", "resets", "chase_field_updates",
+  "allocations", "allocated_bytes",
+};
+
+const char* const kPhaseNames[kNumInstrumentationPhases] = {
+  "turn", "input", "move_people", "handle_current_position", "render",
+};
+
+// An HDR-style latency histogram: values below 2^kSubBits are counted
+// exactly, and every larger power-of-two range is split into 2^kSubBits
+// equal sub-buckets, so every recorded value is known to within about 3%
+// no matter how large it is.
+class LatencyHistogram {
+  public:
+    static const unsigned kSubBits = 5;
+    static const unsigned kSubBuckets = 1u << kSubBits;
+    static const unsigned kNumBuckets = (64 - kSubBits + 1) * kSubBuckets;
+
+    void Record(std::uint64_t value);
+    void Merge(const LatencyHistogram& other);
+    std::uint64_t Percentile(double p) const;
+    void WriteJson(std::ostream& os) const;
+
+  private:
+    std::uint64_t counts_[kNumBuckets] = {};
+    std::uint64_t total_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t min_ = UINT64_MAX;
+    std::uint64_t max_ = 0;
+
+    static unsigned BucketOf(std::uint64_t value);
+    static std::uint64_t BucketUpperBound(unsigned bucket);
+};
+
+/*********************************************************************
+** Function: BucketOf
+** Description: Returns the bucket a value is counted in.
+** Parameters: value is the value.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+unsigned LatencyHistogram::BucketOf(std::uint64_t value) {
+  if (value < kSubBuckets) return static_cast<unsigned>(value);
+
+  unsigned magnitude = 63 - __builtin_clzll(value);
+  unsigned shift = magnitude - kSubBits;
+  unsigned sub = static_cast<unsigned>(value >> shift) & (kSubBuckets - 1);
+  return (shift + 1) * kSubBuckets + sub;
+}
+
+/*********************************************************************
+** Function: BucketUpperBound
+** Description: Returns the largest value counted in a bucket.
+** Parameters: bucket is the bucket.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::uint64_t LatencyHistogram::BucketUpperBound(unsigned bucket) {
+  if (bucket < kSubBuckets) return bucket;
+
+  unsigned shift = bucket / kSubBuckets - 1;
+  std::uint64_t sub = bucket % kSubBuckets;
+  return ((kSubBuckets + sub + 1) << shift) - 1;
+}
+
+/*********************************************************************
+** Function: Record
+** Description: Adds one sample to the histogram.
+** Parameters: value is the sample.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void LatencyHistogram::Record(std::uint64_t value) {
+  ++counts_[BucketOf(value)];
+  ++total_;
+  sum_ += value;
+  if (value < min_) min_ = value;
+  if (value > max_) max_ = value;
+}
+
+/*********************************************************************
+** Function: Merge
+** Description: Adds every sample of another histogram to this one.
+** Parameters: other is the histogram to add.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (unsigned i = 0; i != kNumBuckets; ++i) counts_[i] += other.counts_[i];
+  total_ += other.total_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+/*********************************************************************
+** Function: Percentile
+** Description: Returns (an upper bound of) the given percentile.
+** Parameters: p is the percentile, from 0 to 100.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::uint64_t LatencyHistogram::Percentile(double p) const {
+  if (total_ == 0) return 0;
+
+  auto rank = static_cast<std::uint64_t>(p / 100.0 * total_ + 0.5);
+  if (rank == 0) rank = 1;
+
+  std::uint64_t seen = 0;
+  for (unsigned i = 0; i != kNumBuckets; ++i) {
+    seen += counts_[i];
+    if (seen >= rank) return std::min(BucketUpperBound(i), max_);
+  }
+  return max_;
+}
+
+/*********************************************************************
+** Function: WriteJson
+** Description: Writes the histogram's summary and non-empty buckets (as
+ * [upper bound, count] pairs) as a JSON object.
+** Parameters: os is the stream to write to.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void LatencyHistogram::WriteJson(std::ostream& os) const {
+  os << "{\"count\": " << total_
+     << ", \"min_ns\": " << (total_ != 0 ? min_ : 0)
+     << ", \"max_ns\": " << max_
+     << ", \"mean_ns\": " << (total_ != 0 ? sum_ / total_ : 0)
+     << ", \"p50_ns\": " << Percentile(50)
+     << ", \"p90_ns\": " << Percentile(90)
+     << ", \"p99_ns\": " << Percentile(99)
+     << ", \"p999_ns\": " << Percentile(99.9)
+     << ", \"buckets\": [";
+
+  bool first = true;
+  for (unsigned i = 0; i != kNumBuckets; ++i) {
+    if (counts_[i] == 0) continue;
+    os << (first ? "" : ", ") << '[' << BucketUpperBound(i) << ", "
+       << counts_[i] << ']';
+    first = false;
+  }
+  os << "]}";
+}
+
+// One thread's histograms. Its lock is only ever contended by a dump, so
+// recording stays cheap even when many threads play games at once (e.g.,
+// the win estimator's rollouts).
+struct ThreadHistograms {
+  std::mutex mutex;
+  LatencyHistogram phases[kNumInstrumentationPhases];
+};
+
+// Counters may be bumped from any thread. Each thread records phase
+// latencies into its own histograms, which a dump merges; the histograms
+// outlive their threads so that their samples still count.
+std::atomic<std::uint64_t> counters[kNumInstrumentationCounters];
+std::mutex thread_histograms_mutex;
+std::list<ThreadHistograms> thread_histograms;
+thread_local ThreadHistograms* current_histograms = nullptr;
+
+// Atomic rather than volatile, since any thread playing a game may poll it.
+std::atomic<int> dump_requested(0);
+
+/*********************************************************************
+** Function: CurrentHistograms
+** Description: Returns the calling thread's histograms, registering them on
+ * the thread's first call.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+ThreadHistograms& CurrentHistograms() {
+  if (current_histograms == nullptr) {
+    std::lock_guard<std::mutex> lock(thread_histograms_mutex);
+    thread_histograms.emplace_back();
+    current_histograms = &thread_histograms.back();
+  }
+  return *current_histograms;
+}
+
+/*********************************************************************
+** Function: RequestDump
+** Description: SIGUSR1 handler; only sets a flag, since writing the dump is
+ * not async-signal-safe.
+** Parameters: The signal number.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+extern "C" void RequestDump(int) {
+  dump_requested = 1;
+}
+
+// Installs the exit hook and the signal handler before main runs.
+struct InstrumentationSetup {
+  InstrumentationSetup() {
+    std::atexit(DumpInstrumentation);
+    std::signal(SIGUSR1, RequestDump);
+  }
+} instrumentation_setup;
+
+}  // namespace
+
+/*********************************************************************
+** Function: CountEvent
+** Description: Adds to one of the counters.
+** Parameters: counter is the counter; amount is the amount to add.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void CountEvent(InstrumentationCounter counter, std::uint64_t amount) {
+  counters[counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+/*********************************************************************
+** Function: CounterValue
+** Description: Returns the current value of one of the counters.
+** Parameters: counter is the counter.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::uint64_t CounterValue(InstrumentationCounter counter) {
+  return counters[counter].load(std::memory_order_relaxed);
+}
+
+/*********************************************************************
+** Function: RecordPhaseLatency
+** Description: Records one sample of a phase's latency.
+** Parameters: phase is the phase; ns is its duration in nanoseconds.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void RecordPhaseLatency(InstrumentationPhase phase, std::uint64_t ns) {
+  ThreadHistograms& histograms = CurrentHistograms();
+  std::lock_guard<std::mutex> lock(histograms.mutex);
+  histograms.phases[phase].Record(ns);
+}
+
+/*********************************************************************
+** Function: PollInstrumentationDump
+** Description: Writes the dump if SIGUSR1 has been received since the last
+ * poll.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void PollInstrumentationDump() {
+  if (dump_requested.load(std::memory_order_relaxed) != 0 &&
+      dump_requested.exchange(0) != 0) {
+    DumpInstrumentation();
+  }
+}
+
+/*********************************************************************
+** Function: DumpInstrumentation
+** Description: Writes every counter and histogram as JSON (see the header),
+ * merging each phase's histograms across threads.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void DumpInstrumentation() {
+  const char* path = std::getenv("ESC162_INSTRUMENT_FILE");
+  std::ofstream os(path != nullptr ? path : "instrumentation.json");
+  if (!os) return;
+
+  os << "{\n  \"counters\": {";
+  for (unsigned i = 0; i != kNumInstrumentationCounters; ++i) {
+    os << (i != 0 ? ", " : "") << '"' << kCounterNames[i] << "\": "
+       << counters[i].load(std::memory_order_relaxed);
+  }
+
+  LatencyHistogram merged[kNumInstrumentationPhases];
+  {
+    std::lock_guard<std::mutex> lock(thread_histograms_mutex);
+    for (ThreadHistograms& histograms : thread_histograms) {
+      std::lock_guard<std::mutex> thread_lock(histograms.mutex);
+      for (unsigned i = 0; i != kNumInstrumentationPhases; ++i) {
+        merged[i].Merge(histograms.phases[i]);
+      }
+    }
+  }
+
+  os << "},\n  \"phases\": {\n";
+  for (unsigned i = 0; i != kNumInstrumentationPhases; ++i) {
+    os << "    \"" << kPhaseNames[i] << "\": ";
+    merged[i].WriteJson(os);
+    os << (i + 1 != kNumInstrumentationPhases ? ",\n" : "\n");
+  }
+  os << "  }\n}\n";
+}
+
+/*********************************************************************
+** Function: operator new
+** Description: Replaces the global operator new to count allocations.
+** Parameters: size is the number of bytes to allocate.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void* operator new(std::size_t size) {
+  counters[kCounterAllocations].fetch_add(1, std::memory_order_relaxed);
+  counters[kCounterAllocatedBytes].fetch_add(size, std::memory_order_relaxed);
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+/*********************************************************************
+** Function: operator delete
+** Description: Replaces the global operator delete to match operator new.
+** Parameters: p is the memory to free.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+/*********************************************************************
+** Function: operator delete
+** Description: Sized version of operator delete.
+** Parameters: p is the memory to free.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+#endif
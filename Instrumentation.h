@@ -0,0 +1,93 @@
+#ifndef ESCAPEFROMCS162_INSTRUMENTATION_H
+#define ESCAPEFROMCS162_INSTRUMENTATION_H
+/*********************************************************************
+** Program Filename: Instrumentation.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the opt-in instrumentation of the game loop: event
+ * counters and per-phase latency histograms.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+// Instrumentation is compiled in only when ESC162_INSTRUMENT is defined (build
+// with `make INSTRUMENT=1`). Otherwise every macro below expands to nothing,
+// so release builds pay nothing for it.
+//
+// When compiled in, the counters and histograms are written as JSON to the
+// file named by the ESC162_INSTRUMENT_FILE environment variable (default:
+// instrumentation.json) when the program exits, and whenever the process
+// receives SIGUSR1 (at the next ESC162_INSTRUMENT_POLL).
+#ifdef ESC162_INSTRUMENT
+
+#include <chrono>
+#include <cstdint>
+
+enum InstrumentationCounter {
+  kCounterSpaceAt,
+  kCounterLocationAt,
+  kCounterTaMoves,
+  kCounterResets,
+  kCounterChaseFieldUpdates,
+  kCounterAllocations,
+  kCounterAllocatedBytes,
+  kNumInstrumentationCounters,
+};
+
+enum InstrumentationPhase {
+  kPhaseTurn,
+  kPhaseInput,
+  kPhaseMovePeople,
+  kPhaseHandleCurrentPosition,
+  kPhaseRender,
+  kNumInstrumentationPhases,
+};
+
+void CountEvent(InstrumentationCounter counter, std::uint64_t amount);
+std::uint64_t CounterValue(InstrumentationCounter counter);
+void RecordPhaseLatency(InstrumentationPhase phase, std::uint64_t ns);
+void PollInstrumentationDump();
+void DumpInstrumentation();
+
+// Records the time from its construction to its destruction as one sample of
+// the given phase.
+class PhaseTimer {
+  public:
+    explicit PhaseTimer(InstrumentationPhase phase):
+        phase_(phase), start_(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() {
+      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start_).count();
+      RecordPhaseLatency(phase_, static_cast<std::uint64_t>(ns));
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+  private:
+    InstrumentationPhase phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#define ESC162_INSTRUMENT_CONCAT_(a, b) a##b
+#define ESC162_INSTRUMENT_CONCAT(a, b) ESC162_INSTRUMENT_CONCAT_(a, b)
+
+#define ESC162_COUNT(counter) CountEvent(counter, 1)
+#define ESC162_COUNT_BY(counter, amount) CountEvent(counter, amount)
+#define ESC162_TIME_PHASE(phase) \
+  PhaseTimer ESC162_INSTRUMENT_CONCAT(phase_timer_, __LINE__)(phase)
+#define ESC162_INSTRUMENT_POLL() PollInstrumentationDump()
+
+#else
+
+#define ESC162_COUNT(counter) do {} while (0)
+#define ESC162_COUNT_BY(counter, amount) do {} while (0)
+#define ESC162_TIME_PHASE(phase) do {} while (0)
+#define ESC162_INSTRUMENT_POLL() do {} while (0)
+
+#endif
+
+
+#endif //ESCAPEFROMCS162_INSTRUMENTATION_H
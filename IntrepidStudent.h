@@ -19,8 +19,8 @@ class IntrepidStudent : public MazePerson {
     Option<PlayerAction>
     GetMove(std::vector<PlayerAction> valid_moves) override;
 
-    void Occupy(OpenSpace* space) override { space->set_has_student(true); }
-    void Unoccupy(OpenSpace* space) override { space->set_has_student(false); }
+    void Occupy(OpenSpace space) override { space.set_has_student(true); }
+    void Unoccupy(OpenSpace space) override { space.set_has_student(false); }
 
     bool HasSkills() const { return prog_skills_ > 0; }
 
@@ -32,6 +32,7 @@ class IntrepidStudent : public MazePerson {
     }
 
     unsigned prog_skills() const { return prog_skills_; }
+    void set_prog_skills(unsigned skills) { prog_skills_ = skills; }
 
   private:
     unsigned prog_skills_ = 0;
@@ -0,0 +1,66 @@
+/*********************************************************************
+** Program Filename: MappedFile.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the MappedFile class and in
+ * the MappedFile header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.h"
+
+/*********************************************************************
+** Function: MappedFile
+** Description: Constructor for the MappedFile class; maps the whole file
+ * into memory and throws if it can't be opened or mapped.
+** Parameters: path is the path of the file to map.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+MappedFile::MappedFile(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Unable to open " + path + ".");
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw std::runtime_error("Unable to read the size of " + path + ".");
+  }
+
+  size_ = static_cast<std::size_t>(st.st_size);
+
+  // mmap refuses zero-length mappings; an empty file is just an empty view.
+  if (size_ != 0) {
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Unable to map " + path + " into memory.");
+    }
+
+    // The file is parsed front to back exactly once.
+    madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(addr);
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+}
+
+/*********************************************************************
+** Function: ~MappedFile
+** Description: Destructor for the MappedFile class.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+MappedFile::~MappedFile() {
+  if (data_ != nullptr)
+    munmap(const_cast<char*>(data_), size_);
+}
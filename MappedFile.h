@@ -0,0 +1,38 @@
+#ifndef ESCAPEFROMCS162_MAPPEDFILE_H
+#define ESCAPEFROMCS162_MAPPEDFILE_H
+/*********************************************************************
+** Program Filename: MappedFile.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the MappedFile class and its related members.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstddef>
+#include <string>
+
+// A read-only, memory-mapped view of an entire file. The mapping is released
+// when the MappedFile is destroyed, so pointers into data() must not outlive
+// it.
+class MappedFile {
+  public:
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    const char* end() const { return data_ + size_; }
+    std::size_t size() const { return size_; }
+
+  private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+
+#endif //ESCAPEFROMCS162_MAPPEDFILE_H
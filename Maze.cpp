@@ -7,94 +7,293 @@
 ** Input: None
 ** Output: None
 *********************************************************************/
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <unistd.h>
 #include "Maze.h"
+#include "Checkpoint.h"
+#include "FrameBuilder.h"
+#include "Instrumentation.h"
+#include "MappedFile.h"
+#include "MazeBinary.h"
+#include "Parallel.h"
+#include "StudentPolicy.h"
+
+// Room for the lines printed by PrintStatus, so composing a frame around them
+// doesn't have to grow its buffer.
+const std::size_t kStatusSizeHint = 256;
 
 /*********************************************************************
 ** Function: Maze
 ** Description: Constructor for the Maze class.
-** Parameters: is is the stream from which to read the maze data file.
+** Parameters: is is the stream from which to read the maze data file; seed
+ * is the master seed for every random choice the maze makes.
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-Maze::Maze(std::ifstream &is) {
+Maze::Maze(std::ifstream &is, std::uint64_t seed): seed_(seed) {
   // Let the Unwrap throw if the info couldn't be read.
   MazeInfo info = ReadMazeInfo(is).Unwrap();
+  CheckMazeInfo(info);
 
-  // The bounds for width and height should definitely be higher, but this
-  // simply checks that we have positive values.
-  if (info.levels < 1 || info.width < 1 || info.height < 1) {
-    throw std::runtime_error("Levels, height, and width must all be >= 1.");
-  }
-
-  // Avoids calling the (default) copy constructor of MazeLevel on each
-  // iteration, which will cause a segfault from a double free. (Why implement
-  // a copy constructor if we can just do this, right?)
+  // Avoids moving every level already parsed each time the vector grows.
   levels_.reserve(info.levels);
   for (unsigned i = 0; i != info.levels; ++i) {
     // MazeLevel constructor will throw if the maze data file is invalid.
     levels_.emplace_back(is, i, info.height, info.width);
   }
 
-  // Is there an instructor on the final level?
-  if (levels_[info.levels - 1].instructor_location() == nullptr) {
-    throw std::runtime_error("Error parsing the maze: no instructor found on "
-                             "final level.");
-  } else {
-    // Are there multiple instructors?
-    for (unsigned i = 0; i != info.levels; ++i) {
-      if (levels_[i].instructor_location() != nullptr && i < (info.levels - 1))
-        throw std::runtime_error("Error parsing the maze: instructor found on "
-                                 "a level other than the final one.");
+  PlacePeople(info);
+}
+
+/*********************************************************************
+** Function: Maze
+** Description: Constructor for the Maze class that memory-maps the maze data
+ * file and parses it in place, without copying each row into a string; also
+ * accepts compiled (.mazeb) mazes. With more than one thread, the levels are
+ * parsed and populated in parallel (see LoadLevelsInParallel).
+** Parameters: path is the path to the maze data file; threads is the number
+ * of threads to load the levels with; seed is the master seed for every
+ * random choice the maze makes.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Maze::Maze(const std::string& path, unsigned threads, std::uint64_t seed):
+    seed_(seed) {
+  MappedFile file(path);
+
+  if (IsBinaryMaze(file.data(), file.size())) {
+    MazeBinaryHeader header = ReadMazeBinaryHeader(file.data(), file.size());
+    MazeInfo info{static_cast<int>(header.levels),
+                  static_cast<int>(header.height),
+                  static_cast<int>(header.width)};
+
+    auto parse_level = [&](unsigned i) {
+        return MazeLevel(
+            ReadMazeBinaryLevel(file.data(), file.size(), header, i), i,
+            header.height, header.width);
+    };
+
+    if (threads > 1) {
+      LoadLevelsInParallel(info, threads, parse_level);
+      return;
+    }
+
+    levels_.reserve(info.levels);
+    for (unsigned i = 0; i != header.levels; ++i) {
+      levels_.push_back(parse_level(i));
     }
+
+    PlacePeople(info);
+    return;
   }
 
-  auto starting_loc = levels_[0].start_location();
-  starting_loc->set_has_student(true);
-  student_ = new IntrepidStudent(starting_loc->pos());
+  const char* cursor = file.data();
+
+  // Let the Unwrap throw if the info couldn't be read.
+  MazeInfo info = ReadMazeInfo(cursor, file.end()).Unwrap();
+  CheckMazeInfo(info);
+
+  if (threads > 1) {
+    // Every level is exactly height lines long, so the level boundaries can
+    // be found by counting newlines; levels past the end of a truncated file
+    // start at the end and fail to parse like they would sequentially.
+    std::vector<const char*> level_starts;
+    level_starts.reserve(info.levels);
+    for (int i = 0; i != info.levels; ++i) {
+      level_starts.push_back(cursor);
+      for (int row = 0; row != info.height && cursor != file.end(); ++row) {
+        auto remaining = static_cast<std::size_t>(file.end() - cursor);
+        auto newline =
+            static_cast<const char*>(memchr(cursor, '\n', remaining));
+        cursor = newline != nullptr ? newline + 1 : file.end();
+      }
+    }
 
-  auto instructor_loc = levels_[info.levels - 1].instructor_location();
-  instructor_loc->set_has_instructor(true);
-  instructor_ = new Instructor(instructor_loc->pos());
+    LoadLevelsInParallel(info, threads, [&](unsigned i) {
+        const char* level_cursor = level_starts[i];
+        return MazeLevel(level_cursor, file.end(), i, info.height, info.width);
+    });
+    return;
+  }
 
-  try {
-    PlaceTAs();
-    PlaceSkills();
-  } catch (...) {
-    // Let's salvage all the memory we can if an exception is thrown here...
-    FreePeople();
-    throw;
+  levels_.reserve(info.levels);
+  for (int i = 0; i != info.levels; ++i) {
+    levels_.emplace_back(cursor, file.end(), i, info.height, info.width);
   }
+
+  PlacePeople(info);
 }
 
 /*********************************************************************
-** Function: ~Maze
-** Description: Destructor for the Maze class.
-** Parameters: None
+** Function: LoadLevelsInParallel
+** Description: Parses every level and places its TAs and skills on a pool of
+ * worker threads, then places the student and instructor. Errors are reported
+ * exactly as the sequential load would report them: the lowest level's parse
+ * error first, then the instructor checks, then the lowest level's TA
+ * placement error, then the lowest level's skill placement error.
+** Parameters: info is the parsed first line of the maze data file; threads is
+ * the number of threads to use; parse_level parses the given level and must
+ * be safe to call from several threads at once.
+** Pre-Conditions: No levels have been loaded yet.
+** Post-Conditions: None
+*********************************************************************/
+void Maze::LoadLevelsInParallel(const MazeInfo& info, unsigned threads,
+    const std::function<MazeLevel(unsigned)>& parse_level) {
+  const unsigned n = info.levels;
+  std::vector<std::unique_ptr<MazeLevel>> parsed(n);
+  std::vector<std::exception_ptr> parse_errors(n);
+  std::vector<std::exception_ptr> ta_errors(n);
+  std::vector<std::exception_ptr> skill_errors(n);
+  tas_.resize(n);
+  ta_index_.resize(n);
+  sampled_cells_.resize(n);
+  SeedLevelRngs(n);
+
+  ParallelFor(n, threads, [&](unsigned long i) {
+      try {
+        parsed[i].reset(new MazeLevel(parse_level(i)));
+      } catch (...) {
+        parse_errors[i] = std::current_exception();
+        return;
+      }
+
+      MazeLevel& level = *parsed[i];
+
+      // The sequential load marks the instructor's space before placing
+      // anything, so it is never picked as an empty space.
+      if (i == n - 1 && level.instructor_index().IsSome())
+        level.instructor_location().Unwrap().set_has_instructor(true);
+
+      try {
+        PlaceTAsAtLevel(level);
+      } catch (...) {
+        ta_errors[i] = std::current_exception();
+        return;
+      }
+
+      try {
+        PlaceSkillsAtLevel(level);
+      } catch (...) {
+        skill_errors[i] = std::current_exception();
+      }
+  });
+
+  auto rethrow_first = [](const std::vector<std::exception_ptr>& errors) {
+      for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+      }
+  };
+
+  rethrow_first(parse_errors);
+
+  levels_.reserve(n);
+  for (auto& level : parsed) {
+    levels_.push_back(std::move(*level));
+  }
+
+  PlaceStudentAndInstructor(info);
+
+  rethrow_first(ta_errors);
+  rethrow_first(skill_errors);
+}
+
+/*********************************************************************
+** Function: CheckMazeInfo
+** Description: Throws if the maze's dimensions are unusable.
+** Parameters: info is the parsed first line of the maze data file.
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-Maze::~Maze() {
-  FreePeople();
+void Maze::CheckMazeInfo(const MazeInfo& info) {
+  // The bounds for width and height should definitely be higher, but this
+  // simply checks that we have positive values.
+  if (info.levels < 1 || info.width < 1 || info.height < 1) {
+    throw std::runtime_error("Levels, height, and width must all be >= 1.");
+  }
+}
+
+/*********************************************************************
+** Function: PlacePeople
+** Description: Checks that the instructor is on (only) the final level, then
+ * places the student, instructor, TAs, and skills on the parsed levels.
+** Parameters: info is the parsed first line of the maze data file.
+** Pre-Conditions: Every level has been parsed.
+** Post-Conditions: None
+*********************************************************************/
+void Maze::PlacePeople(const MazeInfo& info) {
+  SeedLevelRngs(info.levels);
+  PlaceStudentAndInstructor(info);
+  PlaceTAs();
+  PlaceSkills();
 }
 
 /*********************************************************************
-** Function: FreePeople
-** Description: Helper function that acts as a destructor; avoids repeating
- * destructor code in multiple places.
-** Parameters: None
+** Function: SeedLevelRngs
+** Description: Derives each level's generator from the master seed; since
+ * every level has its own stream, the levels can be populated in any order
+ * (or in parallel) and still come out the same.
+** Parameters: levels is the number of levels in the maze.
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-void Maze::FreePeople() {
-  delete student_;
+void Maze::SeedLevelRngs(unsigned levels) {
+  level_rngs_.clear();
+  level_rngs_.reserve(levels);
+  for (unsigned i = 0; i != levels; ++i) {
+    level_rngs_.push_back(Rng::ForStream(seed_, i));
+  }
+}
+
+/*********************************************************************
+** Function: Reseed
+** Description: Replaces the level generators and every TA's generator with
+ * ones derived from a new master seed.
+** Parameters: seed is the new master seed.
+** Pre-Conditions: None
+** Post-Conditions: Nothing but the generators (and seed()) changes.
+*********************************************************************/
+void Maze::Reseed(std::uint64_t seed) {
+  seed_ = seed;
+  SeedLevelRngs(levels_.size());
+  for (unsigned i = 0; i != tas_.size(); ++i) {
+    for (TA& ta : tas_[i]) ta.set_rng(level_rngs_[i].Split());
+  }
+}
 
-  for (auto& row : tas_) {
-    for (auto& ta : row) {
-      delete ta;
+/*********************************************************************
+** Function: PlaceStudentAndInstructor
+** Description: Checks that the instructor is on (only) the final level, then
+ * places the student and instructor on the parsed levels.
+** Parameters: info is the parsed first line of the maze data file.
+** Pre-Conditions: Every level has been parsed.
+** Post-Conditions: None
+*********************************************************************/
+void Maze::PlaceStudentAndInstructor(const MazeInfo& info) {
+  // Is there an instructor on the final level?
+  if (levels_[info.levels - 1].instructor_location().IsNone()) {
+    throw std::runtime_error("Error parsing the maze: no instructor found on "
+                             "final level.");
+  } else {
+    // Are there multiple instructors?
+    for (unsigned i = 0; i != info.levels; ++i) {
+      if (levels_[i].instructor_location().IsSome() && i < (info.levels - 1))
+        throw std::runtime_error("Error parsing the maze: instructor found on "
+                                 "a level other than the final one.");
     }
   }
 
-  delete instructor_;
+  auto starting_loc = levels_[0].start_location();
+  starting_loc.set_has_student(true);
+  student_ = IntrepidStudent(starting_loc.pos());
+
+  auto instructor_loc = levels_[info.levels - 1].instructor_location().Unwrap();
+  instructor_loc.set_has_instructor(true);
+  instructor_ = Instructor(instructor_loc.pos());
 }
 
 /*********************************************************************
@@ -106,15 +305,28 @@ void Maze::FreePeople() {
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-MoveResult Maze::HandleOccupiedSpace(OpenSpace* space) {
-  if (space->has_ta()) {
-    TA* ta = TaAt(space->pos()).Unwrap();
+MoveResult Maze::HandleOccupiedSpace(OpenSpace space) {
+  MazeLevel& level = levels_[space.pos().level];
+  return HandleOccupiedCell(level, level.IndexOf(space.pos()));
+}
+
+/*********************************************************************
+** Function: HandleOccupiedCell
+** Description: Same as HandleOccupiedSpace, for a cell given by its index;
+ * reads the level's TA and skill planes.
+** Parameters: level is the student's level; index is the student's cell.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+MoveResult Maze::HandleOccupiedCell(MazeLevel& level, unsigned index) {
+  if (level.plane(kCellTa).Test(index)) {
+    TA* ta = TaAt(level.PositionOf(index)).Unwrap();
     if (!ta->IsAppeased()) {
       return MoveResult::CaughtByTA;
     }
-  } else if (space->has_skill()) {
-    student_->IncrementSkills();
-    space->set_has_skill(false);
+  } else if (level.plane(kCellSkill).Test(index)) {
+    student_.IncrementSkills();
+    level.SetFlag(index, kCellSkill, false);
     return MoveResult::AcquiredSkill;
   }
 
@@ -130,18 +342,31 @@ MoveResult Maze::HandleOccupiedSpace(OpenSpace* space) {
 ** Post-Conditions: None
 *********************************************************************/
 MoveResult Maze::HandleCurrentPosition() {
-  MoveResult res = HandleOccupiedSpace(SpaceAt(student_->position()).Unwrap());
+  ESC162_TIME_PHASE(kPhaseHandleCurrentPosition);
+  MazeLevel& level = CurrentStudentLevel();
+  const unsigned index = level.IndexOf(student_.position());
+  MoveResult res = HandleOccupiedCell(level, index);
   if (res == MoveResult::CaughtByTA) return res;
 
-  auto adjacent_spaces = SpacesAdjacentToStudent().Unwrap();
-  for (auto& space : adjacent_spaces) {
-    if (space->has_ta()) {
-      TA *ta = TaAt(space->pos()).Unwrap();
+  // Most turns have no TA or instructor anywhere near the student, which
+  // testing a few bits of their planes rules out.
+  if (!level.AnyNear(index, kCellTa | kCellInstructor)) return res;
+
+  const BitPlane& tas = level.plane(kCellTa);
+  const BitPlane& instructor = level.plane(kCellInstructor);
+  const unsigned mask = level.MoveMaskAt(index);
+  for (unsigned d = 0; d != kNumPlayerDirections; ++d) {
+    if ((mask & (1u << d)) == 0) continue;
+    unsigned neighbor =
+        level.NeighborIndex(index, static_cast<PlayerDirectionAction>(d));
+
+    if (tas.Test(neighbor)) {
+      TA *ta = TaAt(level.PositionOf(neighbor)).Unwrap();
       if (!ta->IsAppeased()) {
         return MoveResult::CaughtByTA;
       }
-    } else if (space->has_instructor()) {
-      if (student_->prog_skills() < 3) {
+    } else if (instructor.Test(neighbor)) {
+      if (student_.prog_skills() < 3) {
         return MoveResult::FailedByInstructor;
       } else {
         return MoveResult::SatisfiedInstructor;
@@ -154,47 +379,96 @@ MoveResult Maze::HandleCurrentPosition() {
 
 /*********************************************************************
 ** Function: MovePeople
-** Description: Prompts user to pick an action and performs that action; also
- * handles moving the TAs. This should be called each turn.
+** Description: Prompts user (or asks the student policy, if one is set) to
+ * pick an action and performs that action; also handles moving the TAs. This
+ * should be called each turn.
 ** Parameters: None
 ** Pre-Conditions: None
-** Post-Conditions: None
+** Post-Conditions: Returns the action the student performed.
 *********************************************************************/
-void Maze::MovePeople() {
-  MazePosition s_pos = student_->position();
-  PlayerAction s_move = student_->GetMove(ValidActionsAt(s_pos)).Unwrap();
+PlayerAction Maze::MovePeople() {
+  MazePosition s_pos = student_.position();
+  std::vector<PlayerAction> valid_actions = ValidActionsAt(s_pos);
+  PlayerAction s_move = ChooseStudentAction(valid_actions);
+
+  // Everything after the student's choice counts as moving people.
+  ESC162_TIME_PHASE(kPhaseMovePeople);
 
   // Did the student demonstrate a skill?
   bool appease_tas = false;
 
   switch (s_move) {
     case PlayerAction::ClimbUp: {
-      SpaceAt(s_pos).Unwrap()->set_has_student(false);
+      SpaceAt(s_pos).Unwrap().set_has_student(false);
       auto start_loc = levels_[s_pos.level + 1].start_location();
-      start_loc->set_has_student(true);
-      student_->set_position(start_loc->pos());
-      std::cout << "\nYou have climbed up to level " << (s_pos.level + 2)
-                << ".\n";
+      start_loc.set_has_student(true);
+      student_.set_position(start_loc.pos());
       break;
     }
     case PlayerAction::DemonstrateSkill:
-      student_->DecrementSkills();
+      student_.DecrementSkills();
       appease_tas = true;
-      std::cout << "\nYou demonstrated a skill to the TAs; you now have "
-                << student_->prog_skills() << " skills remaining.\n";
       break;
     default:
-      MovePerson(student_, s_move);
+      MovePerson(&student_, s_move);
       break;
   }
 
-  for (auto& ta : tas_[student_->position().level]) {
-    MazePosition ta_pos = ta->position();
-    auto valid_moves = ValidMovementsAt(ta_pos);
-    PlayerAction ta_move = ta->GetMove(valid_moves).Unwrap();
-    MovePerson(ta, ta_move);
+  MazeLevel& level = CurrentStudentLevel();
+  bool chase = ta_behavior_ == TaBehavior::Chase;
+  if (chase) UpdateChaseField(level);
+
+  auto& level_tas = tas_[level.number()];
+  for (unsigned id = 0; id != level_tas.size(); ++id) {
+    TA* ta = &level_tas[id];
+    unsigned index = level.IndexOf(ta->position());
+    unsigned move_mask = level.MoveMaskAt(index);
+    PlayerAction ta_move = chase
+        ? ta->GetChaseMove(move_mask, chase_field_.StepFrom(index)).Unwrap()
+        : ta->GetMoveFromMask(move_mask).Unwrap();
+    MoveTA(level, id, ta_move);
     if (appease_tas) ta->Appease();
   }
+
+  return s_move;
+}
+
+/*********************************************************************
+** Function: UpdateChaseField
+** Description: Points the chase field at the student, unless it already
+ * points at the student's cell.
+** Parameters: level is the student's level.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void Maze::UpdateChaseField(const MazeLevel& level) {
+  unsigned index = level.IndexOf(student_.position());
+  if (has_chase_field_ && chase_level_ == level.number() &&
+      chase_index_ == index) {
+    return;
+  }
+
+  ESC162_COUNT(kCounterChaseFieldUpdates);
+  chase_field_.Compute(level, index);
+  has_chase_field_ = true;
+  chase_level_ = level.number();
+  chase_index_ = index;
+}
+
+/*********************************************************************
+** Function: ChooseStudentAction
+** Description: Prompts the user (or asks the student policy, if one is set)
+ * to pick the student's action for this turn.
+** Parameters: valid_actions are the actions valid at the student's position.
+** Pre-Conditions: valid_actions is not empty.
+** Post-Conditions: None
+*********************************************************************/
+PlayerAction Maze::ChooseStudentAction(
+    const std::vector<PlayerAction>& valid_actions) {
+  ESC162_TIME_PHASE(kPhaseInput);
+  return student_policy_ != nullptr
+      ? student_policy_->ChooseAction(*this, valid_actions)
+      : student_.GetMove(valid_actions).Unwrap();
 }
 
 /*********************************************************************
@@ -223,6 +497,28 @@ bool Maze::MovePerson(MazePerson *person, PlayerAction move) {
   return true;
 }
 
+/*********************************************************************
+** Function: MoveTA
+** Description: Same as MovePerson, but for a TA; also keeps the level's TA
+ * index up to date, and keeps the space's TA flag set if another TA is still
+ * standing there.
+** Parameters: level is the TA's level; id is the TA's index on the level;
+ * move is the direction.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+bool Maze::MoveTA(MazeLevel& level, unsigned id, PlayerAction move) {
+  ESC162_COUNT(kCounterTaMoves);
+  TA* ta = &tas_[level.number()][id];
+  unsigned from = level.IndexOf(ta->position());
+  if (!MovePerson(ta, move)) return false;
+
+  OccupantIndex& index = ta_index_[level.number()];
+  index.Move(id, level.IndexOf(ta->position()));
+  if (index.Occupied(from)) level.SetFlag(from, kCellTa, true);
+  return true;
+}
+
 /*********************************************************************
 ** Function: ResetAllLevels
 ** Description: Resets all maze levels to their original state, moves the
@@ -235,12 +531,12 @@ void Maze::ResetAllLevels() {
   for (auto& level : levels_) {
     ResetLevel(level);
     // ResetLevel places the student at the beginning of the reset level.
-    level.start_location()->set_has_student(false);
+    level.start_location().set_has_student(false);
   }
 
   auto start_loc = levels_[0].start_location();
-  start_loc->set_has_student(true);
-  student_->set_position(start_loc->pos());
+  start_loc.set_has_student(true);
+  student_.set_position(start_loc.pos());
 }
 
 /*********************************************************************
@@ -264,19 +560,14 @@ void Maze::ResetCurrentLevel() {
 ** Post-Conditions: None
 *********************************************************************/
 void Maze::ResetLevel(MazeLevel& level) {
+  ESC162_COUNT(kCounterResets);
   level.Reset();
 
   auto start_loc = level.start_location();
-  unsigned level_n = start_loc->pos().level;
-
-  delete student_;
-  for (auto& ta : tas_[level_n]) {
-    delete ta;
-  }
 
-  start_loc->set_has_student(true);
-  student_ = new IntrepidStudent(start_loc->pos());
-  tas_[level_n] = PlaceTAsAtLevel(level);
+  start_loc.set_has_student(true);
+  student_ = IntrepidStudent(start_loc.pos());
+  PlaceTAsAtLevel(level);
   PlaceSkillsAtLevel(level);
 }
 
@@ -288,7 +579,7 @@ void Maze::ResetLevel(MazeLevel& level) {
 ** Post-Conditions: None
 *********************************************************************/
 MazeLevel& Maze::CurrentStudentLevel() {
-  return levels_[student_->position().level];
+  return levels_[student_.position().level];
 }
 
 /*********************************************************************
@@ -298,7 +589,8 @@ MazeLevel& Maze::CurrentStudentLevel() {
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-Option<MazeLocation*> Maze::LocationAt(MazePosition pos) {
+Option<MazeLocation> Maze::LocationAt(MazePosition pos) {
+  ESC162_COUNT(kCounterLocationAt);
   if (pos.level >= levels_.size()) return None;
   MazeLevel& level = levels_[pos.level];
   return level.LocationAt(pos);
@@ -312,10 +604,10 @@ Option<MazeLocation*> Maze::LocationAt(MazePosition pos) {
 ** Post-Conditions: None
 *********************************************************************/
 Option<TA*> Maze::TAOnLevel(MazeLevel& level) {
-  auto level_n = level.start_location()->pos().level;
+  auto level_n = level.number();
   if (tas_.size() > level_n) {
-    if (!tas_.empty()) {
-      return tas_[level_n][0];
+    if (!tas_[level_n].empty()) {
+      return &tas_[level_n][0];
     }
   }
 
@@ -329,11 +621,10 @@ Option<TA*> Maze::TAOnLevel(MazeLevel& level) {
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-Option<OpenSpace*> Maze::SpaceAt(MazePosition pos) {
-  return LocationAt(pos).AndThen<OpenSpace*>([&](MazeLocation* loc) {
-      if (!loc->occupiable()) return Option<OpenSpace*>(None);
-      return Option<OpenSpace*>(dynamic_cast<OpenSpace*>(loc));
-  });
+Option<OpenSpace> Maze::SpaceAt(MazePosition pos) {
+  ESC162_COUNT(kCounterSpaceAt);
+  if (pos.level >= levels_.size()) return None;
+  return levels_[pos.level].SpaceAt(pos);
 }
 
 /*********************************************************************
@@ -344,18 +635,11 @@ Option<OpenSpace*> Maze::SpaceAt(MazePosition pos) {
 ** Post-Conditions: None
 *********************************************************************/
 Option<TA*> Maze::TaAt(MazePosition pos) {
-  return SpaceAt(pos).AndThen<TA*>([&](OpenSpace* space) {
-      if (space->has_ta()) {
-        MazePosition space_pos = space->pos();
-        for (auto &ta : tas_[space_pos.level]) {
-          if (ta->position() == space_pos) {
-            return Option<TA*>(ta);
-          }
-        }
-      }
+  if (SpaceAt(pos).IsNone()) return None;
 
-      return Option<TA*>(None);
-  });
+  auto& level_tas = tas_[pos.level];
+  return ta_index_[pos.level].First(levels_[pos.level].IndexOf(pos))
+      .Map<TA*>([&](unsigned id) { return &level_tas[id]; });
 }
 
 /*********************************************************************
@@ -366,15 +650,17 @@ Option<TA*> Maze::TaAt(MazePosition pos) {
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-Option<std::vector<OpenSpace*>> Maze::SpacesAdjacentTo(MazePosition pos) {
-  return SpaceAt(pos).Map<std::vector<OpenSpace*>>([&](OpenSpace* space) {
-      std::vector<OpenSpace*> spaces;
-
-      for (const auto& dir : AllPlayerDirectionActions()) {
-        if (CanMoveInDirection(space->pos(), dir)) {
-          MazePosition pos_c = space->pos();
-          pos_c.Translate(dir, 1);
-          spaces.push_back(SpaceAt(pos_c).Unwrap());
+Option<std::vector<OpenSpace>> Maze::SpacesAdjacentTo(MazePosition pos) {
+  return SpaceAt(pos).Map<std::vector<OpenSpace>>([&](OpenSpace space) {
+      MazeLevel& level = levels_[pos.level];
+      unsigned index = level.IndexOf(space.pos());
+      unsigned mask = level.MoveMaskAt(index);
+      std::vector<OpenSpace> spaces;
+
+      for (unsigned d = 0; d != kNumPlayerDirections; ++d) {
+        if (mask & (1u << d)) {
+          auto dir = static_cast<PlayerDirectionAction>(d);
+          spaces.push_back(level.SpaceAtIndex(level.NeighborIndex(index, dir)));
         }
       }
 
@@ -389,8 +675,8 @@ Option<std::vector<OpenSpace*>> Maze::SpacesAdjacentTo(MazePosition pos) {
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-Option<std::vector<OpenSpace*>> Maze::SpacesAdjacentToStudent() {
-  return SpacesAdjacentTo(student_->position());
+Option<std::vector<OpenSpace>> Maze::SpacesAdjacentToStudent() {
+  return SpacesAdjacentTo(student_.position());
 }
 
 /*********************************************************************
@@ -402,11 +688,10 @@ Option<std::vector<OpenSpace*>> Maze::SpacesAdjacentToStudent() {
 ** Post-Conditions: None
 *********************************************************************/
 bool Maze::CanMoveInDirection(MazePosition pos, PlayerDirectionAction dir) {
-  return SpaceAt(pos).Map<bool>([&](OpenSpace* space) {
-      MazePosition move_pos = space->pos();
-      move_pos.Translate(dir, 1);
-      return SpaceAt(move_pos).IsSome();
-  }).UnwrapOr(false);
+  if (pos.level >= levels_.size()) return false;
+  MazeLevel& level = levels_[pos.level];
+  if (pos.row >= level.height() || pos.col >= level.width()) return false;
+  return level.CanMove(level.IndexOf(pos), dir);
 }
 
 /*********************************************************************
@@ -419,14 +704,14 @@ bool Maze::CanMoveInDirection(MazePosition pos, PlayerDirectionAction dir) {
 std::vector<PlayerAction> Maze::ValidActionsAt(MazePosition pos) {
   std::vector<PlayerAction> valid_actions = ValidMovementsAt(pos);
 
-  bool can_climb_ladder = SpaceAt(student_->position()).Map<bool>(
-      [&](OpenSpace* space) {
-          return space->has_ladder();
+  bool can_climb_ladder = SpaceAt(student_.position()).Map<bool>(
+      [&](OpenSpace space) {
+          return space.has_ladder();
       }
   ).UnwrapOr(false);
 
   if (can_climb_ladder) valid_actions.push_back(PlayerAction::ClimbUp);
-  if (student_->HasSkills())
+  if (student_.HasSkills())
     valid_actions.push_back(PlayerAction::DemonstrateSkill);
 
   return valid_actions;
@@ -442,16 +727,232 @@ std::vector<PlayerAction> Maze::ValidActionsAt(MazePosition pos) {
 *********************************************************************/
 std::vector<PlayerAction> Maze::ValidMovementsAt(MazePosition pos) {
   std::vector<PlayerAction> movements;
+  if (pos.level >= levels_.size()) return movements;
+  MazeLevel& level = levels_[pos.level];
+  if (pos.row >= level.height() || pos.col >= level.width()) return movements;
 
-  for (const auto& dir : AllPlayerDirectionActions()) {
-    if (CanMoveInDirection(pos, dir)) {
-      movements.push_back(PlayerDirectionToAction(dir));
+  unsigned mask = level.MoveMaskAt(level.IndexOf(pos));
+  for (unsigned d = 0; d != kNumPlayerDirections; ++d) {
+    if (mask & (1u << d)) {
+      movements.push_back(
+          PlayerDirectionToAction(static_cast<PlayerDirectionAction>(d)));
     }
   }
 
   return movements;
 }
 
+/*********************************************************************
+** Function: LayoutHash
+** Description: Returns the FNV-1a hash of the maze's size and, for every
+ * level, its beginning, ladder, and instructor cells and its walls; computed
+ * the first time it is needed.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::uint64_t Maze::LayoutHash() {
+  if (has_layout_hash_) return layout_hash_;
+
+  std::uint64_t hash = kFnv1aOffsetBasis;
+  auto mix = [&](std::uint64_t value, unsigned bytes) {
+      unsigned char le[8];
+      for (unsigned i = 0; i != bytes; ++i) le[i] = (value >> (8 * i)) & 0xFF;
+      hash = Fnv1a(hash, le, bytes);
+  };
+  auto mix_cell = [&](Option<unsigned> index) {
+      mix(index.UnwrapOr(UINT32_MAX), 4);
+  };
+
+  mix(levels_.size(), 4);
+  mix(levels_.front().height(), 4);
+  mix(levels_.front().width(), 4);
+  for (const auto& level : levels_) {
+    mix(level.start_index(), 4);
+    mix_cell(level.ladder_index());
+    mix_cell(level.instructor_index());
+    for (std::uint64_t word : level.plane(kCellWall).words()) mix(word, 8);
+  }
+
+  layout_hash_ = hash;
+  has_layout_hash_ = true;
+  return hash;
+}
+
+/*********************************************************************
+** Function: SaveCheckpoint
+** Description: Writes the game's mutable state as a checkpoint, in one call.
+** Parameters: os is the stream to write to.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void Maze::SaveCheckpoint(std::ostream& os) {
+  CheckpointWriter out;
+  out.PutBytes(kCheckpointMagic, sizeof(kCheckpointMagic));
+  out.Put<std::uint32_t>(kCheckpointVersion);
+  out.Put<std::uint64_t>(LayoutHash());
+  out.Put<std::uint64_t>(seed_);
+  out.Put<std::uint32_t>(levels_.size());
+
+  MazePosition pos = student_.position();
+  out.Put<std::uint32_t>(pos.level);
+  out.Put<std::uint32_t>(pos.row);
+  out.Put<std::uint32_t>(pos.col);
+  out.Put<std::uint32_t>(student_.prog_skills());
+
+  std::vector<unsigned> skill_cells;
+  for (const auto& level : levels_) {
+    out.PutRng(level_rngs_[level.number()]);
+
+    const std::vector<TA>& level_tas = tas_[level.number()];
+    out.Put<std::uint32_t>(level_tas.size());
+    for (const auto& ta : level_tas) {
+      out.Put<std::uint32_t>(ta.position().row);
+      out.Put<std::uint32_t>(ta.position().col);
+      out.Put<std::uint32_t>(ta.appeased_turns());
+      out.PutRng(ta.rng());
+    }
+
+    // Skills can only be on cells touched since the last reset, so there's no
+    // need to look at the rest of the level. They're saved in cell order, so
+    // the same state always saves the same way.
+    skill_cells.clear();
+    for (unsigned index : level.touched_cells()) {
+      if (level.cell(index) & kCellSkill) skill_cells.push_back(index);
+    }
+    std::sort(skill_cells.begin(), skill_cells.end());
+
+    out.Put<std::uint32_t>(skill_cells.size());
+    for (unsigned index : skill_cells) out.Put<std::uint32_t>(index);
+  }
+
+  out.WriteTo(os);
+}
+
+/*********************************************************************
+** Function: LoadCheckpoint
+** Description: Replaces the game's mutable state with a checkpoint's. The
+ * whole checkpoint is read and checked before anything is changed.
+** Parameters: is is the stream to read the checkpoint from.
+** Pre-Conditions: None
+** Post-Conditions: Throws, leaving the game unchanged, if the checkpoint is
+ * invalid or belongs to a different maze.
+*********************************************************************/
+void Maze::LoadCheckpoint(std::istream& is) {
+  CheckpointReader in(is);
+
+  if (memcmp(in.GetBytes(sizeof(kCheckpointMagic)), kCheckpointMagic,
+             sizeof(kCheckpointMagic)) != 0) {
+    throw std::runtime_error("File is not a checkpoint.");
+  }
+
+  std::uint32_t version = in.Get<std::uint32_t>();
+  if (version != kCheckpointVersion) {
+    throw std::runtime_error("Checkpoint has unsupported version " +
+                             std::to_string(version) + ".");
+  }
+
+  if (in.Get<std::uint64_t>() != LayoutHash())
+    throw std::runtime_error("Checkpoint was saved from a different maze.");
+
+  std::uint64_t seed = in.Get<std::uint64_t>();
+  if (in.Get<std::uint32_t>() != levels_.size())
+    throw std::runtime_error("Checkpoint was saved from a different maze.");
+
+  // Returns the index of the open cell at the given position of the given
+  // level, throwing if there is none.
+  auto open_cell = [&](unsigned level_n, unsigned row, unsigned col) {
+      MazePosition pos{level_n, row, col};
+      if (level_n >= levels_.size() || levels_[level_n].SpaceAt(pos).IsNone())
+        throw std::runtime_error("Checkpoint has a person or skill off the "
+                                 "maze's open spaces.");
+      return levels_[level_n].IndexOf(pos);
+  };
+
+  // Same as open_cell, but also throws if the cell is the beginning, the
+  // ladder, or the instructor's, where skills are never placed (and skills
+  // never move). TAs only need open_cell, since they wander onto those cells.
+  auto empty_cell = [&](unsigned level_n, unsigned row, unsigned col) {
+      unsigned index = open_cell(level_n, row, col);
+      const MazeCell fixed = kCellBeginning | kCellLadder | kCellInstructor;
+      if ((levels_[level_n].cell(index) & fixed) != 0)
+        throw std::runtime_error("Checkpoint has a person or skill off the "
+                                 "maze's open spaces.");
+      return index;
+  };
+
+  MazePosition student_pos;
+  student_pos.level = in.Get<std::uint32_t>();
+  student_pos.row = in.Get<std::uint32_t>();
+  student_pos.col = in.Get<std::uint32_t>();
+  unsigned student_index =
+      open_cell(student_pos.level, student_pos.row, student_pos.col);
+  unsigned prog_skills = in.Get<std::uint32_t>();
+
+  std::vector<Rng> rngs;
+  std::vector<std::vector<TA>> tas(levels_.size());
+  std::vector<std::vector<unsigned>> skills(levels_.size());
+  rngs.reserve(levels_.size());
+
+  for (const auto& level : levels_) {
+    const unsigned n = level.number();
+    const unsigned cells = level.height() * level.width();
+    rngs.push_back(in.GetRng());
+
+    std::uint32_t ta_count = in.Get<std::uint32_t>();
+    if (ta_count == 0 || ta_count > cells)
+      throw std::runtime_error("Checkpoint has an invalid number of TAs.");
+    tas[n].reserve(ta_count);
+    for (std::uint32_t i = 0; i != ta_count; ++i) {
+      unsigned row = in.Get<std::uint32_t>();
+      unsigned col = in.Get<std::uint32_t>();
+      open_cell(n, row, col);
+      unsigned appeased_turns = in.Get<std::uint32_t>();
+
+      tas[n].emplace_back(MazePosition{n, row, col}, in.GetRng());
+      tas[n].back().set_appeased_turns(appeased_turns);
+    }
+
+    std::uint32_t skill_count = in.Get<std::uint32_t>();
+    if (skill_count > cells)
+      throw std::runtime_error("Checkpoint has an invalid number of skills.");
+    skills[n].reserve(skill_count);
+    for (std::uint32_t i = 0; i != skill_count; ++i) {
+      std::uint32_t index = in.Get<std::uint32_t>();
+      if (index >= cells)
+        throw std::runtime_error("Checkpoint has a skill outside its level.");
+      skills[n].push_back(empty_cell(n, index / level.width(),
+                                     index % level.width()));
+    }
+  }
+
+  if (!in.AtEnd())
+    throw std::runtime_error("Checkpoint has unexpected trailing data.");
+
+  // Everything checked out; swap the state in. Resetting a level only undoes
+  // what changed since its last reset, so this is proportional to the size of
+  // the game's state, not of the maze.
+  seed_ = seed;
+  level_rngs_ = std::move(rngs);
+
+  for (auto& level : levels_) {
+    const unsigned n = level.number();
+    level.Reset();
+
+    tas_[n] = std::move(tas[n]);
+    for (const auto& ta : tas_[n]) {
+      level.SetFlag(level.IndexOf(ta.position()), kCellTa, true);
+    }
+    IndexTAsAtLevel(level);
+
+    for (unsigned index : skills[n]) level.SetFlag(index, kCellSkill, true);
+  }
+
+  student_ = IntrepidStudent(student_pos);
+  student_.set_prog_skills(prog_skills);
+  levels_[student_pos.level].SetFlag(student_index, kCellStudent, true);
+}
+
 /*********************************************************************
 ** Function: PrintCurrentLevel
 ** Description: Prints the map of the student's current level.
@@ -464,28 +965,49 @@ void Maze::PrintCurrentLevel() {
 }
 
 /*********************************************************************
-** Function: PrintState
-** Description: Prints the state of the maze.
-** Parameters: None
+** Function: PrintStatus
+** Description: Prints the student's skills, position, and remaining levels,
+ * and whether the TAs are appeased, followed by a blank line.
+** Parameters: os is the stream to print to.
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-void Maze::PrintState() {
-  auto levels_left = levels_.size() - (student_->position().level + 1);
-  std::cout << "# of Programming Skills: " << student_->prog_skills() << '\n'
-            << "Current Position: " << student_->position() << '\n'
-            << "Remaining Levels: " << levels_left << '\n'
-            << "TAs Appeased: ";
+void Maze::PrintStatus(std::ostream& os) {
+  auto levels_left = levels_.size() - (student_.position().level + 1);
+  os << "# of Programming Skills: " << student_.prog_skills() << '\n'
+     << "Current Position: " << student_.position() << '\n'
+     << "Remaining Levels: " << levels_left << '\n'
+     << "TAs Appeased: ";
   TA* ta = TAOnLevel(CurrentStudentLevel()).Unwrap();
 
   if (ta->IsAppeased()) {
-    std::cout << "Yes; " << ta->appeased_turns() << " turns remaining\n\n";
+    os << "Yes; " << ta->appeased_turns() << " turns remaining\n\n";
   } else {
-    std::cout << "No\n\n";
+    os << "No\n\n";
   }
+}
 
-  PrintCurrentLevel();
-  std::cout << '\n';
+/*********************************************************************
+** Function: PrintState
+** Description: Prints the state of the maze.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void Maze::PrintState() {
+  ESC162_TIME_PHASE(kPhaseRender);
+  const MazeLevel& level = CurrentStudentLevel();
+
+  // The header and the level are composed into one buffer and sent to the
+  // terminal with a single write.
+  FrameBuilder frame;
+  frame.Reserve(kStatusSizeHint + FrameBuilder::LevelSize(level) + 1);
+  PrintStatus(frame.stream());
+  frame.AppendLevel(level);
+  frame.Append('\n');
+
+  std::cout.flush();
+  frame.WriteTo(STDOUT_FILENO);
 }
 
 /*********************************************************************
@@ -496,39 +1018,65 @@ void Maze::PrintState() {
 ** Post-Conditions: None
 *********************************************************************/
 void Maze::PlaceTAs() {
+  tas_.resize(levels_.size());
+  ta_index_.resize(levels_.size());
+  sampled_cells_.resize(levels_.size());
   for (auto& level : levels_) {
-    tas_.push_back(PlaceTAsAtLevel(level));
+    PlaceTAsAtLevel(level);
   }
 }
 
 /*********************************************************************
 ** Function: PlaceTAsAtLevel
-** Description: Randomly places two TAs on the given level of the maze; this
- * function will throw if there are no empty spaces.
+** Description: Randomly places two TAs on the given level of the maze and
+ * indexes them; this function will throw if there are no empty spaces.
 ** Parameters: level is the level on which to place TAs.
-** Pre-Conditions: None
+** Pre-Conditions: The level has no TAs on it (e.g., it was just reset).
 ** Post-Conditions: None
 *********************************************************************/
-std::vector<TA*> Maze::PlaceTAsAtLevel(MazeLevel& level) {
-  auto level_tas = level.RandomEmptySpaces(2).Map<std::vector<TA*>>(
-      [&](std::vector<OpenSpace*> spaces) {
-          std::vector<TA*> tas;
+void Maze::PlaceTAsAtLevel(MazeLevel& level) {
+  unsigned level_n = level.number();
+  Rng& rng = level_rngs_[level_n];
 
-          for (auto& space : spaces) {
-            tas.push_back(new TA(space->pos()));
-            space->set_has_ta(true);
-          }
+  // Replaces any previous TAs in place, reusing their storage.
+  std::vector<TA>& level_tas = tas_[level_n];
+  level_tas.clear();
 
-          return tas;
-      }
-  );
-
-  if (level_tas.IsNone()) {
+  std::vector<unsigned>& cells = sampled_cells_[level_n];
+  if (!level.RandomEmptySpaces(2, rng, cells)) {
     throw std::runtime_error(
         "Grid is not large enough to place TAs on one or more levels.");
   }
 
-  return level_tas.Unwrap();
+  for (unsigned index : cells) {
+    OpenSpace space = level.SpaceAtIndex(index);
+    level_tas.emplace_back(space.pos(), rng.Split());
+    space.set_has_ta(true);
+  }
+
+  IndexTAsAtLevel(level);
+}
+
+/*********************************************************************
+** Function: IndexTAsAtLevel
+** Description: Rebuilds the index of the TAs on the given level, reusing its
+ * storage when it can.
+** Parameters: level is the level whose TAs to index.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void Maze::IndexTAsAtLevel(const MazeLevel& level) {
+  const std::vector<TA>& level_tas = tas_[level.number()];
+  OccupantIndex& index = ta_index_[level.number()];
+  if (index.cells() != level.height() * level.width()) {
+    index = OccupantIndex(level.height() * level.width());
+  } else {
+    index.Clear();
+  }
+
+  for (unsigned id = 0; id != level_tas.size(); ++id) {
+    index.Add(level.IndexOf(level_tas[id].position()), id);
+  }
 }
 
 /*********************************************************************
@@ -553,19 +1101,14 @@ void Maze::PlaceSkills() {
 ** Post-Conditions: None
 *********************************************************************/
 void Maze::PlaceSkillsAtLevel(MazeLevel& level) {
-  bool placed = level.RandomEmptySpaces(3).Map<bool>(
-      [&](std::vector<OpenSpace*> spaces) {
-          for (auto& space : spaces) {
-            space->set_has_skill(true);
-          }
-          return true;
-      }
-  ).UnwrapOr(false);
-
-  if (!placed) {
+  Rng& rng = level_rngs_[level.number()];
+  std::vector<unsigned>& cells = sampled_cells_[level.number()];
+  if (!level.RandomEmptySpaces(3, rng, cells)) {
     throw std::runtime_error(
         "Grid is not large enough to place skills on one or more levels.");
   }
+
+  for (unsigned index : cells) level.SpaceAtIndex(index).set_has_skill(true);
 }
 
 /*********************************************************************
@@ -584,7 +1127,49 @@ Option<Maze::MazeInfo> Maze::ReadMazeInfo(std::ifstream& is) {
   std::istringstream iss(row_str);
   MazeInfo info;
   iss >> info.levels >> info.height >> info.width;
-  if (!is) return None;
+  if (!iss) return None;
+  return info;
+}
+
+/*********************************************************************
+** Function: ReadMazeInfo
+** Description: Same as ReadMazeInfo, but parses the first line of an
+ * in-memory copy of the maze data file.
+** Parameters: cursor points to the start of the data and is advanced past
+ * the first line; end is the end of the data.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Option<Maze::MazeInfo> Maze::ReadMazeInfo(const char*& cursor,
+    const char* end) {
+  if (cursor == end) return None;
+
+  auto newline = static_cast<const char*>(
+      memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+  const char* line_end = newline != nullptr ? newline : end;
+
+  MazeInfo info;
+  int* fields[] = {&info.levels, &info.height, &info.width};
+
+  // Mirrors `iss >> levels >> height >> width`: whitespace-separated integers,
+  // with anything after the third one ignored.
+  const char* p = cursor;
+  for (int* field : fields) {
+    while (p != line_end && isspace(static_cast<unsigned char>(*p))) ++p;
+
+    bool negative = false;
+    if (p != line_end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+    if (p == line_end || !isdigit(static_cast<unsigned char>(*p))) return None;
+
+    long value = 0;
+    while (p != line_end && isdigit(static_cast<unsigned char>(*p))) {
+      value = value * 10 + (*p++ - '0');
+      if (value > INT_MAX) return None;
+    }
+    *field = static_cast<int>(negative ? -value : value);
+  }
+
+  cursor = newline != nullptr ? newline + 1 : end;
   return info;
 }
 
@@ -596,9 +1181,31 @@ Option<Maze::MazeInfo> Maze::ReadMazeInfo(std::ifstream& is) {
 ** Post-Conditions: None
 *********************************************************************/
 std::ostream& operator<<(std::ostream& os, const Maze& maze) {
+  // One buffer, sized for a single level, is reused for every level, so a dump
+  // costs one allocation and one write per level however large the maze is.
+  FrameBuilder frame;
+  if (!maze.levels_.empty())
+    frame.Reserve(FrameBuilder::LevelSize(maze.levels_.front()) + 1);
+
   for (const auto& level : maze.levels_) {
-    os << level << '\n';
+    frame.Clear();
+    frame.AppendLevel(level);
+    frame.Append('\n');
+    frame.WriteTo(os);
   }
 
   return os;
 }
+
+/*********************************************************************
+** Function: TaBehaviorNamed
+** Description: Returns the TA behavior with the given name.
+** Parameters: name is "wander" or "chase".
+** Pre-Conditions: None
+** Post-Conditions: Returns None for any other name.
+*********************************************************************/
+Option<TaBehavior> TaBehaviorNamed(const std::string& name) {
+  if (name == "wander") return TaBehavior::Wander;
+  if (name == "chase") return TaBehavior::Chase;
+  return None;
+}
@@ -11,13 +11,19 @@
 
 
 #include <fstream>
+#include <functional>
 #include <sstream>
+#include "FlowField.h"
 #include "MazeLevel.h"
+#include "OccupantIndex.h"
 #include "OpenSpace.h"
+#include "Rng.h"
 #include "IntrepidStudent.h"
 #include "TA.h"
 #include "Instructor.h"
 
+class StudentPolicy;
+
 // The result of the student moving on a given turn.
 enum class MoveResult {
   AcquiredSkill,
@@ -27,49 +33,117 @@ enum class MoveResult {
   SatisfiedInstructor,
 };
 
+// How the TAs choose their moves.
+enum class TaBehavior {
+  // Every TA moves in a random direction.
+  Wander,
+  // Unappeased TAs move along a shortest path toward the student; appeased
+  // ones wander.
+  Chase,
+};
+
 class Maze {
   friend std::ostream& operator<<(std::ostream& os, const Maze& maze);
 
   public:
-    explicit Maze(std::ifstream& is);
-
-    ~Maze();
-
-    IntrepidStudent* student() { return student_; };
-
-    MoveResult HandleOccupiedSpace(OpenSpace* space);
+    // Every random choice the maze makes derives from seed, so two mazes
+    // built from the same file and seed play out identically.
+    explicit Maze(std::ifstream& is, std::uint64_t seed = RandomSeed());
+    explicit Maze(const std::string& path, unsigned threads = 1,
+                  std::uint64_t seed = RandomSeed());
+
+    IntrepidStudent* student() { return &student_; };
+    const std::vector<MazeLevel>& levels() const { return levels_; }
+    std::uint64_t seed() const { return seed_; }
+    // Replaces every random generator in the game with ones derived from
+    // seed, leaving everything else as it is, so the rest of the game plays
+    // out differently from the same state.
+    void Reseed(std::uint64_t seed);
+
+    // When a policy is set, it chooses the student's actions instead of the
+    // player; the maze does not take ownership of the policy.
+    void set_student_policy(StudentPolicy* policy) { student_policy_ = policy; }
+    // The TAs wander unless told otherwise. The behavior is not part of a
+    // checkpoint (action logs record it separately), so a resumed game must
+    // be given the one it was played with.
+    TaBehavior ta_behavior() const { return ta_behavior_; }
+    void set_ta_behavior(TaBehavior behavior) { ta_behavior_ = behavior; }
+
+    MoveResult HandleOccupiedSpace(OpenSpace space);
     MoveResult HandleCurrentPosition();
-    void MovePeople();
+    PlayerAction MovePeople();
     bool MovePerson(MazePerson* person, PlayerAction move);
     void ResetAllLevels();
     void ResetCurrentLevel();
     void ResetLevel(MazeLevel& level);
 
     MazeLevel& CurrentStudentLevel();
-    Option<MazeLocation*> LocationAt(MazePosition pos);
+    Option<MazeLocation> LocationAt(MazePosition pos);
     Option<TA*> TAOnLevel(MazeLevel& level);
-    Option<OpenSpace*> SpaceAt(MazePosition pos);
+    Option<OpenSpace> SpaceAt(MazePosition pos);
     Option<TA*> TaAt(MazePosition pos);
 
-    Option<std::vector<OpenSpace*>> SpacesAdjacentTo(MazePosition pos);
-    Option<std::vector<OpenSpace*>> SpacesAdjacentToStudent();
+    Option<std::vector<OpenSpace>> SpacesAdjacentTo(MazePosition pos);
+    Option<std::vector<OpenSpace>> SpacesAdjacentToStudent();
     bool CanMoveInDirection(MazePosition pos, PlayerDirectionAction dir);
     std::vector<PlayerAction> ValidActionsAt(MazePosition pos);
     std::vector<PlayerAction> ValidMovementsAt(MazePosition pos);
 
+    // A hash of every level's walls and fixed cells, which identifies the
+    // maze a checkpoint belongs to whatever file format it was loaded from.
+    std::uint64_t LayoutHash();
+    // Saves or restores everything that changes during a game (see the
+    // Checkpoint header). Loading throws, leaving the game as it was, if the
+    // checkpoint is invalid or was saved from a different maze.
+    void SaveCheckpoint(std::ostream& os);
+    void LoadCheckpoint(std::istream& is);
+
     void PrintCurrentLevel();
     void PrintState();
+    void PrintStatus(std::ostream& os);
 
   private:
     std::vector<MazeLevel> levels_;
 
-    IntrepidStudent* student_;
-    std::vector<std::vector<TA*>> tas_;
-    Instructor* instructor_;
-
-    void FreePeople();
+    std::uint64_t seed_;
+    bool has_layout_hash_ = false;
+    std::uint64_t layout_hash_ = 0;
+    // level_rngs_[i] places level i's TAs and skills and seeds its TAs.
+    std::vector<Rng> level_rngs_;
+
+    // People are stored by value and reinitialized in place on a reset, so
+    // resets don't allocate; tas_[i] keeps its capacity between resets.
+    IntrepidStudent student_{MazePosition()};
+    std::vector<std::vector<TA>> tas_;
+    // ta_index_[i] maps each cell of level i to the TAs (by their index in
+    // tas_[i]) standing on it.
+    std::vector<OccupantIndex> ta_index_;
+    // sampled_cells_[i] receives the empty cells chosen on level i when its
+    // TAs and skills are placed; one per level, so levels can be populated
+    // in parallel, and each keeps its capacity between resets.
+    std::vector<std::vector<unsigned>> sampled_cells_;
+    Instructor instructor_{MazePosition()};
+
+    StudentPolicy* student_policy_ = nullptr;
+
+    TaBehavior ta_behavior_ = TaBehavior::Wander;
+    // Leads every cell of chase_level_ toward chase_index_, where the student
+    // was when it was computed; shared by all the level's TAs, and only
+    // recomputed once the student has moved.
+    FlowField chase_field_;
+    bool has_chase_field_ = false;
+    unsigned chase_level_ = 0;
+    unsigned chase_index_ = 0;
+
+    void SeedLevelRngs(unsigned levels);
+    MoveResult HandleOccupiedCell(MazeLevel& level, unsigned index);
+    PlayerAction ChooseStudentAction(
+        const std::vector<PlayerAction>& valid_actions);
+    bool MoveTA(MazeLevel& level, unsigned id, PlayerAction move);
+    void UpdateChaseField(const MazeLevel& level);
     void PlaceTAs();
-    std::vector<TA*> PlaceTAsAtLevel(MazeLevel& level);
+    void PlaceTAsAtLevel(MazeLevel& level);
+    void IndexTAsAtLevel(const MazeLevel& level);
     void PlaceSkills();
     void PlaceSkillsAtLevel(MazeLevel& level);
 
@@ -80,9 +154,16 @@ class Maze {
       int width;
     };
     Option<MazeInfo> ReadMazeInfo(std::ifstream& is);
+    Option<MazeInfo> ReadMazeInfo(const char*& cursor, const char* end);
+    void CheckMazeInfo(const MazeInfo& info);
+    void LoadLevelsInParallel(const MazeInfo& info, unsigned threads,
+        const std::function<MazeLevel(unsigned)>& parse_level);
+    void PlaceStudentAndInstructor(const MazeInfo& info);
+    void PlacePeople(const MazeInfo& info);
 };
 
 std::ostream& operator<<(std::ostream& os, const Maze& maze);
+Option<TaBehavior> TaBehaviorNamed(const std::string& name);
 
 
 #endif //ESCAPEFROMCS162_MAZE_H
@@ -0,0 +1,217 @@
+/*********************************************************************
+** Program Filename: MazeBinary.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared in the MazeBinary header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <cstring>
+#include <stdexcept>
+#include "MazeBinary.h"
+
+namespace {
+
+const std::size_t kHeaderSize = sizeof(kMazeBinaryMagic) + 4 * 4;
+const std::size_t kLevelRecordHeaderSize = 6 * 4;
+
+/*********************************************************************
+** Function: LoadLE
+** Description: Reads a little-endian unsigned integer from unaligned memory.
+** Parameters: p points to the integer's first byte.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename T>
+T LoadLE(const char* p) {
+  T value;
+  memcpy(&value, p, sizeof(T));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  T swapped = 0;
+  for (std::size_t i = 0; i != sizeof(T); ++i)
+    swapped = static_cast<T>((swapped << 8) | ((value >> (8 * i)) & 0xFF));
+  value = swapped;
+#endif
+  return value;
+}
+
+/*********************************************************************
+** Function: StoreLE
+** Description: Writes an unsigned integer to the stream in little-endian
+ * order.
+** Parameters: os is the stream to write to; value is the integer.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename T>
+void StoreLE(std::ostream& os, T value) {
+  char bytes[sizeof(T)];
+  for (std::size_t i = 0; i != sizeof(T); ++i)
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  os.write(bytes, sizeof(T));
+}
+
+/*********************************************************************
+** Function: StoreCell
+** Description: Writes an optional cell index as a (row, col) pair.
+** Parameters: os is the stream to write to; index is the cell index; width is
+ * the width of the level.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void StoreCell(std::ostream& os, Option<unsigned> index, unsigned width) {
+  if (index.IsNone()) {
+    StoreLE<std::uint32_t>(os, kMazeBinaryNoCell);
+    StoreLE<std::uint32_t>(os, kMazeBinaryNoCell);
+  } else {
+    unsigned i = index.Unwrap();
+    StoreLE<std::uint32_t>(os, i / width);
+    StoreLE<std::uint32_t>(os, i % width);
+  }
+}
+
+/*********************************************************************
+** Function: LoadCell
+** Description: Reads a (row, col) pair written by StoreCell.
+** Parameters: p points to the pair; header describes the maze.
+** Pre-Conditions: None
+** Post-Conditions: Returns None for kMazeBinaryNoCell; throws if the cell is
+ * outside the level.
+*********************************************************************/
+Option<unsigned> LoadCell(const char* p, const MazeBinaryHeader& header) {
+  std::uint32_t row = LoadLE<std::uint32_t>(p);
+  std::uint32_t col = LoadLE<std::uint32_t>(p + 4);
+  if (row == kMazeBinaryNoCell && col == kMazeBinaryNoCell) return None;
+
+  if (row >= header.height || col >= header.width)
+    throw std::runtime_error("Compiled maze has a cell outside its level.");
+  return row * header.width + col;
+}
+
+}  // namespace
+
+/*********************************************************************
+** Function: IsBinaryMaze
+** Description: Returns whether the data starts with the compiled maze magic.
+** Parameters: data is the file's contents; size is its size in bytes.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+bool IsBinaryMaze(const char* data, std::size_t size) {
+  return size >= sizeof(kMazeBinaryMagic)
+      && memcmp(data, kMazeBinaryMagic, sizeof(kMazeBinaryMagic)) == 0;
+}
+
+/*********************************************************************
+** Function: ReadMazeBinaryHeader
+** Description: Reads and checks the header and level offset table of a
+ * compiled maze; throws if the file is truncated or of another version.
+** Parameters: data is the file's contents; size is its size in bytes.
+** Pre-Conditions: IsBinaryMaze(data, size)
+** Post-Conditions: None
+*********************************************************************/
+MazeBinaryHeader ReadMazeBinaryHeader(const char* data, std::size_t size) {
+  if (size < kHeaderSize)
+    throw std::runtime_error("Compiled maze is truncated.");
+
+  const char* p = data + sizeof(kMazeBinaryMagic);
+  std::uint32_t version = LoadLE<std::uint32_t>(p);
+  if (version != kMazeBinaryVersion) {
+    throw std::runtime_error("Compiled maze has unsupported version " +
+                             std::to_string(version) + ".");
+  }
+
+  MazeBinaryHeader header;
+  header.levels = LoadLE<std::uint32_t>(p + 4);
+  header.height = LoadLE<std::uint32_t>(p + 8);
+  header.width = LoadLE<std::uint32_t>(p + 12);
+
+  if (header.levels < 1 || header.height < 1 || header.width < 1) {
+    throw std::runtime_error("Levels, height, and width must all be >= 1.");
+  }
+
+  if ((size - kHeaderSize) / 8 < header.levels)
+    throw std::runtime_error("Compiled maze is truncated.");
+
+  header.level_offsets.reserve(header.levels);
+  for (unsigned i = 0; i != header.levels; ++i) {
+    header.level_offsets.push_back(
+        LoadLE<std::uint64_t>(data + kHeaderSize + 8 * i));
+  }
+
+  return header;
+}
+
+/*********************************************************************
+** Function: ReadMazeBinaryLevel
+** Description: Reads one level record of a compiled maze, using the offset
+ * table so no other level has to be touched.
+** Parameters: data is the file's contents; size is its size in bytes; header
+ * is the maze's header; level is the (zero-indexed) level to read.
+** Pre-Conditions: level < header.levels
+** Post-Conditions: None
+*********************************************************************/
+MazeLevelImage ReadMazeBinaryLevel(const char* data, std::size_t size,
+    const MazeBinaryHeader& header, unsigned level) {
+  const std::uint64_t cells =
+      static_cast<std::uint64_t>(header.height) * header.width;
+  const std::uint64_t words = (cells + 63) / 64;
+  const std::uint64_t offset = header.level_offsets[level];
+
+  if (offset > size || size - offset < kLevelRecordHeaderSize + words * 8)
+    throw std::runtime_error("Compiled maze is truncated.");
+
+  const char* p = data + offset;
+  MazeLevelImage image;
+  image.start_index = LoadCell(p, header).Unwrap();
+  image.ladder_index = LoadCell(p + 8, header);
+  image.instructor_index = LoadCell(p + 16, header);
+
+  image.walls.resize(words);
+  p += kLevelRecordHeaderSize;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  memcpy(image.walls.data(), p, words * 8);
+#else
+  for (std::uint64_t i = 0; i != words; ++i)
+    image.walls[i] = LoadLE<std::uint64_t>(p + 8 * i);
+#endif
+
+  return image;
+}
+
+/*********************************************************************
+** Function: WriteMazeBinary
+** Description: Writes the given (already validated) levels as a compiled
+ * maze.
+** Parameters: os is the stream to write to; levels are the maze's levels.
+** Pre-Conditions: levels is not empty and every level has the same size.
+** Post-Conditions: None
+*********************************************************************/
+void WriteMazeBinary(std::ostream& os, const std::vector<MazeLevel>& levels) {
+  const unsigned height = levels.front().height();
+  const unsigned width = levels.front().width();
+  const std::uint64_t words =
+      (static_cast<std::uint64_t>(height) * width + 63) / 64;
+  const std::uint64_t record_size = kLevelRecordHeaderSize + words * 8;
+
+  os.write(kMazeBinaryMagic, sizeof(kMazeBinaryMagic));
+  StoreLE<std::uint32_t>(os, kMazeBinaryVersion);
+  StoreLE<std::uint32_t>(os, static_cast<std::uint32_t>(levels.size()));
+  StoreLE<std::uint32_t>(os, height);
+  StoreLE<std::uint32_t>(os, width);
+
+  std::uint64_t offset = kHeaderSize + 8 * levels.size();
+  for (std::size_t i = 0; i != levels.size(); ++i) {
+    StoreLE<std::uint64_t>(os, offset);
+    offset += record_size;
+  }
+
+  for (const auto& level : levels) {
+    StoreCell(os, level.start_index(), width);
+    StoreCell(os, level.ladder_index(), width);
+    StoreCell(os, level.instructor_index(), width);
+
+    for (std::uint64_t w : level.plane(kCellWall).words())
+      StoreLE<std::uint64_t>(os, w);
+  }
+}
@@ -0,0 +1,52 @@
+#ifndef ESCAPEFROMCS162_MAZEBINARY_H
+#define ESCAPEFROMCS162_MAZEBINARY_H
+/*********************************************************************
+** Program Filename: MazeBinary.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares functions for reading and writing compiled
+ * (.mazeb) maze files.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "MazeLevel.h"
+
+// A compiled maze is a prevalidated binary image of a maze data file. All
+// integers are little-endian:
+//
+//   char     magic[8]              "MAZEBIN\0"
+//   uint32   version               kMazeBinaryVersion
+//   uint32   levels, height, width
+//   uint64   level_offsets[levels] byte offset of each level record
+//
+// followed by one record per level:
+//
+//   uint32   start_row, start_col
+//   uint32   ladder_row, ladder_col          kMazeBinaryNoCell if none
+//   uint32   instructor_row, instructor_col  kMazeBinaryNoCell if none
+//   uint64   walls[(height * width + 63) / 64]  BitPlane::words() layout
+const char kMazeBinaryMagic[8] = {'M', 'A', 'Z', 'E', 'B', 'I', 'N', '\0'};
+const std::uint32_t kMazeBinaryVersion = 1;
+const std::uint32_t kMazeBinaryNoCell = 0xFFFFFFFF;
+
+struct MazeBinaryHeader {
+  unsigned levels;
+  unsigned height;
+  unsigned width;
+  std::vector<std::uint64_t> level_offsets;
+};
+
+bool IsBinaryMaze(const char* data, std::size_t size);
+MazeBinaryHeader ReadMazeBinaryHeader(const char* data, std::size_t size);
+MazeLevelImage ReadMazeBinaryLevel(const char* data, std::size_t size,
+    const MazeBinaryHeader& header, unsigned level);
+void WriteMazeBinary(std::ostream& os, const std::vector<MazeLevel>& levels);
+
+
+#endif //ESCAPEFROMCS162_MAZEBINARY_H
@@ -7,10 +7,11 @@
 ** Input: None
 ** Output: None
 *********************************************************************/
+#include <cstring>
 #include <fstream>
+#include "FrameBuilder.h"
 #include "MazeLevel.h"
 #include "OpenSpace.h"
-#include "Wall.h"
 
 /*********************************************************************
 ** Function: ConstructWhatString
@@ -45,51 +46,117 @@ std::string MazeLevelParseError::ConstructWhatString(unsigned level,
 ** Post-Conditions: None
 *********************************************************************/
 MazeLevel::MazeLevel(std::ifstream& is, unsigned level, unsigned height,
-    unsigned width): height_(height), width_(width) {
-  locations_.reserve(height);
-
-  try {
-    // This throws whenever the given maze data file can't be parsed.
-    // Considering the program can't run properly without a valid maze data
-    // file, exceptions are the best option here.
-    ParseLevelFromFile(is, level);
-  } catch (...) {
-    FreeLocations();
-    throw;
-  }
+    unsigned width): level_(level), height_(height), width_(width) {
+  // This throws whenever the given maze data file can't be parsed.
+  // Considering the program can't run properly without a valid maze data
+  // file, exceptions are the best option here.
+  ParseLevelFromFile(is);
+  BuildWalls();
+  BuildMoveMasks();
+  BuildMutableState();
 }
 
 /*********************************************************************
-** Function: ~MazeLevel
-** Description: Destructor for the MazeLevel class.
-** Parameters: None
+** Function: MazeLevel
+** Description: Constructor for the MazeLevel class that parses the level
+ * straight from an in-memory copy of the maze data file.
+** Parameters: cursor points to the level's first row and is advanced past its
+ * last row; end is the end of the data; level is the level being parsed;
+ * height is the height of the level; width is the width of the level.
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-MazeLevel::~MazeLevel() {
-  FreeLocations();
+MazeLevel::MazeLevel(const char*& cursor, const char* end, unsigned level,
+    unsigned height, unsigned width): level_(level), height_(height),
+    width_(width) {
+  ParseLevelFromBytes(cursor, end);
+  BuildWalls();
+  BuildMoveMasks();
+  BuildMutableState();
+}
 
-  height_ = 0;
-  width_ = 0;
+/*********************************************************************
+** Function: MazeLevel
+** Description: Constructor for the MazeLevel class that builds the level from
+ * a compiled maze image; only checks what is needed to keep the level
+ * memory-safe, since the image was validated when it was compiled.
+** Parameters: image is the level's compiled contents; level is the level
+ * number; height is the height of the level; width is the width of the level.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+MazeLevel::MazeLevel(MazeLevelImage image, unsigned level, unsigned height,
+    unsigned width): level_(level), height_(height), width_(width) {
+  const unsigned size = height * width;
+  BitPlane walls(height, width, std::move(image.walls));
+
+  cells_.resize(size);
+  for (unsigned i = 0; i != size; ++i) {
+    cells_[i] = walls.Test(i) ? kCellWall : 0;
+  }
+
+  auto place = [&](unsigned index, MazeCell flag, const char* what) {
+      if (index >= size || cells_[index] != 0) {
+        throw MazeLevelParseError(level, std::string("invalid ") + what +
+                                  " in compiled maze");
+      }
+      cells_[index] = flag;
+  };
+
+  place(image.start_index, kCellBeginning, "beginning location");
+  has_start_ = true;
+  start_index_ = image.start_index;
+
+  if (image.ladder_index.IsSome()) {
+    ladder_index_ = image.ladder_index.Unwrap();
+    place(ladder_index_, kCellLadder, "ladder");
+    has_ladder_ = true;
+  }
+
+  if (image.instructor_index.IsSome()) {
+    instructor_index_ = image.instructor_index.Unwrap();
+    // As when parsing, the instructor flag is set when the Maze places them.
+    place(instructor_index_, 0, "instructor");
+    has_instructor_ = true;
+  }
+
+  CheckRequiredCells();
+
+  planes_[PlaneOf(kCellWall)] = std::move(walls);
+
+  BuildMoveMasks();
+  BuildMutableState();
 }
 
 /*********************************************************************
 ** Function: Reset
-** Description: Resets the entire level, removing all skills, students, and TAs.
+** Description: Resets the entire level, removing all skills, students, and
+ * TAs, and returns the empty-cell set to its original order. Only the cells
+ * logged by SetFlag since the last reset are visited, so this takes time
+ * proportional to how much of the level changed.
 ** Parameters: None
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
 void MazeLevel::Reset() {
-  for (auto& row : locations_) {
-    for (auto& loc : row) {
-      if (!loc->occupiable()) continue;
-      auto space = dynamic_cast<OpenSpace*>(loc);
-      space->set_has_ta(false);
-      space->set_has_skill(false);
-      space->set_has_student(false);
-    }
+  for (unsigned index : touched_cells_) {
+    touched_.Clear(index);
+
+    MazeCell cell = cells_[index] & static_cast<MazeCell>(~kResettableFlags);
+    if (cell == cells_[index]) continue;
+    if ((cells_[index] & kCellSkill) != 0)
+      has_distance_field_[static_cast<unsigned>(DistanceTarget::Skill)] = false;
+
+    cells_[index] = cell;
+    planes_[PlaneOf(kCellTa)].Clear(index);
+    planes_[PlaneOf(kCellSkill)].Clear(index);
+    planes_[PlaneOf(kCellStudent)].Clear(index);
+
+    NoteChanged(index);
   }
+
+  touched_cells_.clear();
+  empty_cells_.Restore();
 }
 
 /*********************************************************************
@@ -99,171 +166,433 @@ void MazeLevel::Reset() {
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-Option<MazeLocation*> MazeLevel::LocationAt(MazePosition pos) {
+Option<MazeLocation> MazeLevel::LocationAt(MazePosition pos) {
   if (pos.row >= height_ || pos.col >= width_)
     return None;
 
-  return locations_[pos.row][pos.col];
+  return MazeLocation(this, &cells_[IndexOf(pos)], pos);
 }
 
 /*********************************************************************
-** Function: RandomEmptySpaces
-** Description: Returns the requested number of randomly-chosen empty spaces,
- * if they exist.
-** Parameters: count is the number of spaces to return.
+** Function: instructor_location
+** Description: Returns the space holding the instructor, if this level has
+ * one.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Option<OpenSpace> MazeLevel::instructor_location() {
+  if (!has_instructor_) return None;
+  return SpaceAtIndex(instructor_index_);
+}
+
+/*********************************************************************
+** Function: ladder_index
+** Description: Returns the index of the ladder's cell, if this level has one.
+** Parameters: None
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-Option<std::vector<OpenSpace*>> MazeLevel::RandomEmptySpaces(unsigned count) {
-  return EmptySpacePositions().Map<std::vector<OpenSpace*>>(
-      [&](std::vector<MazePosition> positions) {
-          std::shuffle(positions.begin(), positions.end(), rng_engine_);
-          std::vector<OpenSpace*> spaces;
+Option<unsigned> MazeLevel::ladder_index() const {
+  if (!has_ladder_) return None;
+  return ladder_index_;
+}
 
-          for (const auto& pos : positions) {
-            if (spaces.size() >= count) break;
+/*********************************************************************
+** Function: instructor_index
+** Description: Returns the index of the instructor's cell, if this level has
+ * one.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Option<unsigned> MazeLevel::instructor_index() const {
+  if (!has_instructor_) return None;
+  return instructor_index_;
+}
 
-            auto space = dynamic_cast<OpenSpace*>(LocationAt(pos).Unwrap());
-            spaces.push_back(space);
-          }
+/*********************************************************************
+** Function: SetFlag
+** Description: Sets or clears a flag of the given cell, logging the change
+ * for Reset and renderers.
+** Parameters: index is the cell's index; flag is the flag to change; value is
+ * its new value.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void MazeLevel::SetFlag(unsigned index, MazeCellFlag flag, bool value) {
+  MazeCell old = cells_[index];
+  if (value) cells_[index] |= flag;
+  else cells_[index] &= static_cast<MazeCell>(~flag);
+
+  if (cells_[index] == old) return;
+  planes_[PlaneOf(flag)].Assign(index, value);
+
+  if ((flag & kResettableFlags) != 0 && !touched_.Test(index)) {
+    touched_.Set(index);
+    touched_cells_.push_back(index);
+  }
+
+  NoteChanged(index);
+  if (flag == kCellSkill)
+    has_distance_field_[static_cast<unsigned>(DistanceTarget::Skill)] = false;
+  // The instructor's cell was never in the set (see BuildMutableState).
+  if (old == 0 && empty_cells_.Contains(index)) empty_cells_.Erase(index);
+  else if (cells_[index] == 0) empty_cells_.Insert(index);
+}
 
-          return spaces;
+/*********************************************************************
+** Function: DistanceFieldTo
+** Description: Returns the distance field to the given target, computing it
+ * if it isn't cached.
+** Parameters: target is what to measure distances to.
+** Pre-Conditions: None
+** Post-Conditions: The field stays valid until the target changes; a target
+ * the level doesn't have (e.g., a ladder on the top level) is unreachable
+ * from everywhere.
+*********************************************************************/
+const DistanceField& MazeLevel::DistanceFieldTo(DistanceTarget target) {
+  unsigned t = static_cast<unsigned>(target);
+  if (has_distance_field_[t]) return distance_fields_[t];
+
+  std::vector<unsigned> sources;
+  switch (target) {
+    case DistanceTarget::Ladder:
+      if (has_ladder_) sources.push_back(ladder_index_);
+      break;
+    case DistanceTarget::Instructor:
+      if (has_instructor_) sources.push_back(instructor_index_);
+      break;
+    case DistanceTarget::Skill:
+      // Every skill was placed since the last Reset, so it was logged.
+      for (unsigned index : touched_cells_) {
+        if ((cells_[index] & kCellSkill) != 0) sources.push_back(index);
       }
-  );
+      break;
+  }
+
+  distance_fields_[t].Compute(*this, sources);
+  has_distance_field_[t] = true;
+  return distance_fields_[t];
 }
 
 /*********************************************************************
-** Function: EmptySpacePositions
-** Description: Returns the positions of every empty space on the level.
-** Parameters: None
+** Function: NoteChanged
+** Description: Adds a cell to the list of changed cells, or gives up on the
+ * list once it gets too long to be worth keeping.
+** Parameters: index is the cell's index.
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-Option<std::vector<MazePosition>> MazeLevel::EmptySpacePositions() {
-  std::vector<MazePosition> positions;
-
-  for (const auto& row : locations_) {
-    for (const auto& loc : row) {
-      if (!loc->occupiable()) continue;
-      auto space = dynamic_cast<OpenSpace*>(loc);
-      if (space->IsEmpty()) positions.push_back(space->pos());
-    }
+void MazeLevel::NoteChanged(unsigned index) {
+  if (all_changed_) return;
+
+  if (changed_cells_.size() == kMaxChangedCells) {
+    changed_cells_.clear();
+    all_changed_ = true;
+    return;
+  }
+
+  changed_cells_.push_back(index);
+}
+
+/*********************************************************************
+** Function: AnyNear
+** Description: Returns whether the given cell, or any open cell next to it,
+ * has any of the given flags set; the same as CellsNear(flags).Test(index),
+ * but only the bits of the cell and its neighbors are tested.
+** Parameters: index is the cell's index; flags is a mask of MazeCellFlags
+ * other than kCellWall.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+bool MazeLevel::AnyNear(unsigned index, MazeCell flags) const {
+  // A blocked direction tests the cell itself again, so the bits can be
+  // OR'd together without branching on the level's layout.
+  unsigned near[1 + kNumPlayerDirections] = {index};
+  const unsigned mask = move_masks_[index];
+  for (unsigned d = 0; d != kNumPlayerDirections; ++d)
+    near[d + 1] = (mask & (1u << d)) ? index + neighbor_offsets_[d] : index;
+
+  std::uint64_t bits = 0;
+  for (; flags != 0; flags &= flags - 1) {
+    const std::uint64_t* words = planes_[__builtin_ctz(flags)].words().data();
+    for (unsigned cell : near) bits |= words[cell >> 6] >> (cell & 63);
   }
 
-  if (positions.empty()) return None;
-  return positions;
+  return (bits & 1) != 0;
+}
+
+/*********************************************************************
+** Function: CellsNear
+** Description: Returns a plane of every open cell that has, or is next to a
+ * cell that has, any of the given flags set (e.g., every cell a TA could
+ * catch the student on). Takes a few passes over the level's planes, so it
+ * suits bulk queries rather than a single cell (see AnyNear).
+** Parameters: flags is a mask of MazeCellFlags other than kCellWall.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+BitPlane MazeLevel::CellsNear(MazeCell flags) const {
+  BitPlane cells(height_, width_);
+  for (; flags != 0; flags &= flags - 1)
+    cells.Or(planes_[__builtin_ctz(flags)]);
+
+  cells = cells.Dilated();
+  cells.AndNot(plane(kCellWall));
+  return cells;
+}
+
+/*********************************************************************
+** Function: RandomEmptySpaces
+** Description: Chooses the requested number of distinct, random empty
+ * cells (or every empty cell, if there are fewer). Only the chosen cells are
+ * touched, so this takes O(count) time however large the level is, and it
+ * doesn't allocate once cells has held count indices.
+** Parameters: count is the number of cells to choose; rng is the generator
+ * to choose them with; cells receives the chosen cells' indices, replacing
+ * its contents.
+** Pre-Conditions: None
+** Post-Conditions: Returns false, leaving cells empty, if the level has no
+ * empty cells.
+*********************************************************************/
+bool MazeLevel::RandomEmptySpaces(unsigned count, Rng& rng,
+    std::vector<unsigned>& cells) {
+  cells.clear();
+  if (empty_cells_.empty()) return false;
+
+  if (count > empty_cells_.size()) count = empty_cells_.size();
+  empty_cells_.ShuffleFront(count, rng);
+
+  for (unsigned i = 0; i != count; ++i) cells.push_back(empty_cells_[i]);
+  return true;
 }
 
 /*********************************************************************
 ** Function: ParseLevelFromFile
 ** Description: Reads from the given stream, parsing the data into a maze level.
-** Parameters: is is the stream to read from; level is the level being parsed.
+** Parameters: is is the stream to read from.
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-void MazeLevel::ParseLevelFromFile(std::ifstream &is, unsigned level) {
-  bool has_ladder = false;
+void MazeLevel::ParseLevelFromFile(std::ifstream &is) {
+  cells_.resize(static_cast<std::size_t>(height_) * width_);
 
   for (unsigned i = 0; i != height_; ++i) {
-    std::vector<MazeLocation *> row;
-    row.reserve(width_);
-
     std::string row_str;
 
     if (!std::getline(is, row_str)) {
-      throw MazeLevelParseError(level, "failed to read from stream", i + 1);
+      throw MazeLevelParseError(level_, "failed to read from stream", i + 1);
     }
 
-    if (row_str.size() != width_) {
-      throw MazeLevelParseError(level,
-          "width of row not equal to width of maze", i + 1);
+    ParseRow(row_str.data(), row_str.size(), i);
+  }
+
+  CheckRequiredCells();
+}
+
+/*********************************************************************
+** Function: ParseLevelFromBytes
+** Description: Same as ParseLevelFromFile, but parses the rows directly from
+ * an in-memory (e.g., memory-mapped) copy of the maze data file without
+ * copying them; lines are split exactly as std::getline would split them.
+** Parameters: cursor points to the first row of the level and is advanced
+ * past the level's last row; end is the end of the data.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void MazeLevel::ParseLevelFromBytes(const char*& cursor, const char* end) {
+  cells_.resize(static_cast<std::size_t>(height_) * width_);
+
+  for (unsigned i = 0; i != height_; ++i) {
+    if (cursor == end) {
+      throw MazeLevelParseError(level_, "failed to read from stream", i + 1);
     }
 
-    for (unsigned j = 0; j != width_; ++j) {
-      MazePosition pos{level, i, j};
-
-      switch (row_str[j]) {
-        case ' ':
-          row.push_back(new OpenSpace(pos));
-          break;
-        case '#':
-          row.push_back(new Wall(pos));
-          break;
-        case '@': {
-          if (start_location_ != nullptr) {
-            throw MazeLevelParseError(level, "second beginning location found",
-                                      i + 1, j + 1);
-          }
-
-          auto beg = new OpenSpace(pos);
-          beg->set_is_beginning(true);
-          start_location_ = beg;
-          row.push_back(beg);
-
-          break;
+    auto remaining = static_cast<std::size_t>(end - cursor);
+    auto newline = static_cast<const char*>(memchr(cursor, '\n', remaining));
+    const char* row_end = newline != nullptr ? newline : end;
+
+    ParseRow(cursor, static_cast<std::size_t>(row_end - cursor), i);
+    cursor = newline != nullptr ? newline + 1 : end;
+  }
+
+  CheckRequiredCells();
+}
+
+/*********************************************************************
+** Function: ParseRow
+** Description: Parses a single row of the level into its cells.
+** Parameters: row is the row's characters (not including the newline); len is
+ * the number of characters; i is the zero-indexed row number.
+** Pre-Conditions: cells_ has been sized to hold the whole level.
+** Post-Conditions: None
+*********************************************************************/
+void MazeLevel::ParseRow(const char* row_str, std::size_t len, unsigned i) {
+  if (len != width_) {
+    throw MazeLevelParseError(level_,
+        "width of row not equal to width of maze", i + 1);
+  }
+
+  MazeCell* row = &cells_[static_cast<std::size_t>(i) * width_];
+
+  for (unsigned j = 0; j != width_; ++j) {
+    switch (row_str[j]) {
+      case ' ':
+        row[j] = 0;
+        break;
+      case '#':
+        row[j] = kCellWall;
+        break;
+      case '@': {
+        if (has_start_) {
+          throw MazeLevelParseError(level_, "second beginning location found",
+                                    i + 1, j + 1);
         }
-        case '^': {
-          if (has_ladder) {
-            throw MazeLevelParseError(level, "second ladder found", i + 1,
-                                      j + 1);
-          }
-
-          has_ladder = true;
-          auto ladder = new OpenSpace(pos);
-          ladder->set_has_ladder(true);
-          row.push_back(ladder);
-
-          break;
+
+        row[j] = kCellBeginning;
+        has_start_ = true;
+        start_index_ = i * width_ + j;
+
+        break;
+      }
+      case '^': {
+        if (has_ladder_) {
+          throw MazeLevelParseError(level_, "second ladder found", i + 1,
+                                    j + 1);
         }
 
-        case '%': {
-          if (instructor_location_ != nullptr) {
-            throw MazeLevelParseError(level, "second instructor found", i + 1,
-                                      j + 1);
-          }
+        has_ladder_ = true;
+        ladder_index_ = i * width_ + j;
+        row[j] = kCellLadder;
 
-          auto instructor_loc = new OpenSpace(pos);
-          instructor_location_ = instructor_loc;
-          row.push_back(instructor_loc);
+        break;
+      }
 
-          break;
+      case '%': {
+        if (has_instructor_) {
+          throw MazeLevelParseError(level_, "second instructor found", i + 1,
+                                    j + 1);
         }
 
-        default:
-          throw MazeLevelParseError(level, "unknown character: " +
-              std::string(1, row_str[j]), i + 1, j + 1);
+        // The instructor flag itself is only set once the Maze places the
+        // instructor.
+        row[j] = 0;
+        has_instructor_ = true;
+        instructor_index_ = i * width_ + j;
+
+        break;
       }
+
+      default:
+        throw MazeLevelParseError(level_, "unknown character: " +
+            std::string(1, row_str[j]), i + 1, j + 1);
     }
+  }
+}
 
-    locations_.push_back(row);
+/*********************************************************************
+** Function: CheckRequiredCells
+** Description: Throws if the parsed level is missing its beginning location
+ * or doesn't have exactly one of a ladder and an instructor.
+** Parameters: None
+** Pre-Conditions: Every row of the level has been parsed.
+** Post-Conditions: None
+*********************************************************************/
+void MazeLevel::CheckRequiredCells() const {
+  if (!has_start_) {
+    throw MazeLevelParseError(level_, "no beginning location found");
   }
 
-  if (start_location_ == nullptr) {
-    throw MazeLevelParseError(level, "no beginning location found");
+  if (!has_ladder_ && !has_instructor_) {
+    throw MazeLevelParseError(level_, "no ladder or instructor found");
+  } else if (has_ladder_ && has_instructor_) {
+    throw MazeLevelParseError(level_, "found both an instructor and a ladder");
   }
+}
 
-  if (!has_ladder && instructor_location_ == nullptr) {
-    throw MazeLevelParseError(level, "no ladder or instructor found");
-  } else if (has_ladder && instructor_location_ != nullptr) {
-    throw MazeLevelParseError(level, "found both an instructor and a ladder");
+/*********************************************************************
+** Function: BuildWalls
+** Description: Builds the wall plane from the parsed cells.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void MazeLevel::BuildWalls() {
+  BitPlane& walls = planes_[PlaneOf(kCellWall)];
+  walls = BitPlane(height_, width_);
+
+  for (unsigned i = 0; i != cells_.size(); ++i) {
+    if (cells_[i] & kCellWall) walls.Set(i);
   }
 }
 
 /*********************************************************************
-** Function: FreeLocations
-** Description: Helper function for the destructor; reduces code repetition.
+** Function: BuildMoveMasks
+** Description: Computes the move mask of every cell from the wall plane.
 ** Parameters: None
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-void MazeLevel::FreeLocations() {
-  for (auto& row : locations_) {
-    for (MazeLocation* loc : row)
-      delete loc;
-    row.clear();
+void MazeLevel::BuildMoveMasks() {
+  const int w = static_cast<int>(width_);
+  neighbor_offsets_[static_cast<unsigned>(PlayerDirectionAction::Up)] = -w;
+  neighbor_offsets_[static_cast<unsigned>(PlayerDirectionAction::Down)] = w;
+  neighbor_offsets_[static_cast<unsigned>(PlayerDirectionAction::Left)] = -1;
+  neighbor_offsets_[static_cast<unsigned>(PlayerDirectionAction::Right)] = 1;
+
+  const BitPlane& walls = plane(kCellWall);
+  move_masks_.assign(cells_.size(), 0);
+
+  for (unsigned i = 0; i != cells_.size(); ++i) {
+    if (walls.Test(i)) continue;
+
+    unsigned col = i % width_;
+    std::uint8_t mask = 0;
+    if (i >= width_ && !walls.Test(i - width_))
+      mask |= DirectionBit(PlayerDirectionAction::Up);
+    if (i + width_ < cells_.size() && !walls.Test(i + width_))
+      mask |= DirectionBit(PlayerDirectionAction::Down);
+    if (col != 0 && !walls.Test(i - 1))
+      mask |= DirectionBit(PlayerDirectionAction::Left);
+    if (col + 1 != width_ && !walls.Test(i + 1))
+      mask |= DirectionBit(PlayerDirectionAction::Right);
+    move_masks_[i] = mask;
+  }
+}
+
+/*********************************************************************
+** Function: BuildMutableState
+** Description: Builds the plane of every flag but the wall's, and collects
+ * every empty cell (one with no flags set at all) into empty_cells_; SetFlag
+ * and Reset keep both up to date from then on. Also starts an empty log of
+ * touched cells.
+** Parameters: None
+** Pre-Conditions: cells_ has been filled.
+** Post-Conditions: None
+*********************************************************************/
+void MazeLevel::BuildMutableState() {
+  touched_ = BitPlane(height_, width_);
+
+  for (unsigned f = PlaneOf(kCellWall) + 1; f != kNumCellFlags; ++f)
+    planes_[f] = BitPlane(height_, width_);
+  for (unsigned i = 0; i != cells_.size(); ++i) {
+    if ((cells_[i] & kCellWall) != 0) continue;
+    for (MazeCell flags = cells_[i]; flags != 0; flags &= flags - 1)
+      planes_[__builtin_ctz(flags)].Set(i);
+  }
+
+  empty_cells_ = CellSet(static_cast<unsigned>(cells_.size()));
+  for (unsigned i = 0; i != cells_.size(); ++i) {
+    if (cells_[i] == 0) empty_cells_.Insert(i);
   }
+  // The instructor's flag is only set once the maze has checked it's on the
+  // final level, but nothing may ever be placed on it.
+  if (has_instructor_) empty_cells_.Erase(instructor_index_);
 
-  locations_.clear();
+  // This is the set Reset returns to, in the same order every time, so what
+  // gets placed after a reset depends only on the level and the generator.
+  empty_cells_.Commit();
 }
 
 /*********************************************************************
@@ -274,13 +603,12 @@ void MazeLevel::FreeLocations() {
 ** Post-Conditions: None
 *********************************************************************/
 std::ostream& operator<<(std::ostream& os, const MazeLevel& level) {
-  for (const auto& row : level.locations_) {
-    for (MazeLocation* loc : row) {
-      os << loc->DisplayCharacter();
-    }
-
-    os << '\n';
-  }
+  // The whole level is translated into one buffer and written in one call,
+  // instead of inserting one character at a time.
+  FrameBuilder frame;
+  frame.Reserve(FrameBuilder::LevelSize(level));
+  frame.AppendLevel(level);
+  frame.WriteTo(os);
 
   return os;
 }
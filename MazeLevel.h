@@ -10,8 +10,12 @@
 *********************************************************************/
 
 
+#include "BitPlane.h"
+#include "CellSet.h"
+#include "DistanceField.h"
 #include "MazeLocation.h"
 #include "OpenSpace.h"
+#include "Rng.h"
 
 // Used as a utility to easily create readable exceptions for errors that occur
 // while parsing the data file.
@@ -27,37 +31,167 @@ class MazeLevelParseError : public std::runtime_error {
         Option<unsigned> row, Option<unsigned> col);
 };
 
+// The prevalidated contents of one level of a compiled (.mazeb) maze.
+struct MazeLevelImage {
+  unsigned start_index;
+  Option<unsigned> ladder_index;
+  Option<unsigned> instructor_index;
+  // Packed in the layout of BitPlane::words().
+  std::vector<std::uint64_t> walls;
+};
+
 class MazeLevel {
   friend std::ostream& operator<<(std::ostream& os, const MazeLevel& level);
 
   public:
     MazeLevel(std::ifstream& is, unsigned level, unsigned height,
         unsigned width);
-
-    ~MazeLevel();
+    MazeLevel(const char*& cursor, const char* end, unsigned level,
+        unsigned height, unsigned width);
+    MazeLevel(MazeLevelImage image, unsigned level, unsigned height,
+        unsigned width);
 
     void Reset();
 
-    Option<MazeLocation*> LocationAt(MazePosition pos);
-    Option<std::vector<OpenSpace*>> RandomEmptySpaces(unsigned count);
-
-    OpenSpace* start_location() { return start_location_; }
-    OpenSpace* instructor_location() { return instructor_location_; }
+    Option<MazeLocation> LocationAt(MazePosition pos);
+    bool RandomEmptySpaces(unsigned count, Rng& rng,
+        std::vector<unsigned>& cells);
+
+    OpenSpace start_location() { return SpaceAtIndex(start_index_); }
+    Option<OpenSpace> instructor_location();
+
+    void SetFlag(unsigned index, MazeCellFlag flag, bool value);
+    MazeCell cell(unsigned index) const { return cells_[index]; }
+    // Every cell of the level, in row-major order.
+    const MazeCell* cells() const { return cells_.data(); }
+
+    // Cells whose contents changed since the last ClearChangedCells, so a
+    // renderer can redraw only what moved. Once more than kMaxChangedCells
+    // have changed, only all_changed() is kept.
+    const std::vector<unsigned>& changed_cells() const {
+      return changed_cells_;
+    }
+    bool all_changed() const { return all_changed_; }
+    // Every cell whose TA, skill, or student flags have changed since the last
+    // Reset; no other cell has any of those flags set.
+    const std::vector<unsigned>& touched_cells() const {
+      return touched_cells_;
+    }
+    void ClearChangedCells() {
+      changed_cells_.clear();
+      all_changed_ = false;
+    }
+    // Every cell with the given flag set. The wall plane never changes after
+    // parsing; SetFlag and Reset keep the others in step with the cells.
+    const BitPlane& plane(MazeCellFlag flag) const {
+      return planes_[PlaneOf(flag)];
+    }
+
+    bool CanMove(unsigned index, PlayerDirectionAction dir) const {
+      return (move_masks_[index] & DirectionBit(dir)) != 0;
+    }
+    unsigned MoveMaskAt(unsigned index) const { return move_masks_[index]; }
+    // Only meaningful if CanMove(index, dir) is true.
+    unsigned NeighborIndex(unsigned index, PlayerDirectionAction dir) const {
+      return index + neighbor_offsets_[static_cast<unsigned>(dir)];
+    }
+    bool AnyNear(unsigned index, MazeCell flags) const;
+    BitPlane CellsNear(MazeCell flags) const;
+
+    // Shortest-path queries from any cell to the level's ladder, instructor,
+    // or nearest skill. Each field is computed on first use and kept until
+    // its target changes, which only happens when skills are picked up or
+    // placed.
+    const DistanceField& DistanceFieldTo(DistanceTarget target);
+    Option<unsigned> DistanceTo(DistanceTarget target, unsigned index) {
+      return DistanceFieldTo(target).Distance(index);
+    }
+    Option<std::vector<unsigned>> PathTo(DistanceTarget target,
+        unsigned index) {
+      return DistanceFieldTo(target).PathFrom(*this, index);
+    }
+    unsigned IndexOf(MazePosition pos) const {
+      return pos.row * width_ + pos.col;
+    }
+    MazePosition PositionOf(unsigned index) const {
+      return MazePosition{level_, index / width_, index % width_};
+    }
+    Option<OpenSpace> SpaceAt(MazePosition pos) {
+      if (pos.row >= height_ || pos.col >= width_) return None;
+      unsigned index = IndexOf(pos);
+      if (CellKindOf(cells_[index]) == CellKind::Wall) return None;
+      return OpenSpace(this, &cells_[index], pos);
+    }
+    // The cell at index must not be a wall.
+    OpenSpace SpaceAtIndex(unsigned index) {
+      return OpenSpace(this, &cells_[index], PositionOf(index));
+    }
+
+    unsigned start_index() const { return start_index_; }
+    Option<unsigned> ladder_index() const;
+    Option<unsigned> instructor_index() const;
+
+    unsigned number() const { return level_; }
+    unsigned height() const { return height_; }
+    unsigned width() const { return width_; }
 
   private:
-    std::mt19937 rng_engine_ = MakeRngEngine();
-
-    std::vector<std::vector<MazeLocation*>> locations_;
-
-    OpenSpace* start_location_ = nullptr;
-    OpenSpace* instructor_location_ = nullptr;
-
+    // Row-major; the cell at (row, col) is cells_[row * width_ + col].
+    std::vector<MazeCell> cells_;
+    // One plane per MazeCellFlag, indexed by the flag's bit position; each
+    // mirrors that flag across every cell of cells_.
+    BitPlane planes_[kNumCellFlags];
+    // Walls never change after parsing, so each cell's legal moves (one
+    // DirectionBit per open neighbor) are computed once. Walls have no moves.
+    std::vector<std::uint8_t> move_masks_;
+    // Index offset to the neighbor in each direction, by direction value.
+    int neighbor_offsets_[kNumPlayerDirections];
+
+    // Every cell with no flags set other than the instructor's, i.e., where a
+    // TA or skill may be placed.
+    CellSet empty_cells_;
+
+    // Every cell whose resettable flags SetFlag has changed since the last
+    // Reset, each logged once (touched_ marks the logged cells). Everything
+    // else on the level is still as it was parsed, so Reset only has to undo
+    // these.
+    BitPlane touched_;
+    std::vector<unsigned> touched_cells_;
+
+    // By DistanceTarget; a field is only valid while its has_distance_field_
+    // entry is true.
+    DistanceField distance_fields_[kNumDistanceTargets];
+    bool has_distance_field_[kNumDistanceTargets] = {};
+
+    std::vector<unsigned> changed_cells_;
+    // Starts out true, so nothing is logged until a renderer first clears it.
+    bool all_changed_ = true;
+
+    unsigned start_index_ = 0;
+    bool has_start_ = false;
+    bool has_ladder_ = false;
+    unsigned ladder_index_ = 0;
+    unsigned instructor_index_ = 0;
+    bool has_instructor_ = false;
+
+    unsigned level_;
     unsigned height_;
     unsigned width_;
 
-    Option<std::vector<MazePosition>> EmptySpacePositions();
-    void ParseLevelFromFile(std::ifstream& is, unsigned level);
-    void FreeLocations();
+    static const std::size_t kMaxChangedCells = 1024;
+    // The flags Reset clears; the rest are fixed once the maze is loaded.
+    static const MazeCell kResettableFlags = kCellTa | kCellSkill | kCellStudent;
+
+    static unsigned PlaneOf(MazeCellFlag flag) { return __builtin_ctz(flag); }
+
+    void NoteChanged(unsigned index);
+    void ParseLevelFromFile(std::ifstream& is);
+    void ParseLevelFromBytes(const char*& cursor, const char* end);
+    void ParseRow(const char* row_str, std::size_t len, unsigned i);
+    void CheckRequiredCells() const;
+    void BuildWalls();
+    void BuildMoveMasks();
+    void BuildMutableState();
 };
 
 std::ostream& operator<<(std::ostream& os, const MazeLevel& level);
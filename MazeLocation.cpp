@@ -0,0 +1,64 @@
+/*********************************************************************
+** Program Filename: MazeLocation.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the MazeLocation class and
+ * in the MazeLocation header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include "MazeLocation.h"
+#include "OpenSpace.h"
+
+namespace {
+
+/*********************************************************************
+** Function: ComputeDisplayCharacter
+** Description: Works out the display character for a cell; only used to fill
+ * kCellDisplayCharacters.
+** Parameters: cell is the packed cell record.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+char ComputeDisplayCharacter(unsigned cell) {
+  if (cell & kCellWall) return '#';
+  else if (cell & kCellStudent) return '*';
+  else if (cell & kCellTa) return 'T';
+  else if (cell & kCellSkill) return '$';
+  else if (cell & kCellBeginning) return '@';
+  else if (cell & kCellLadder) return '^';
+  else if (cell & kCellInstructor) return '%';
+  else return ' ';
+}
+
+/*********************************************************************
+** Function: MakeDisplayCharacters
+** Description: Builds the display character table.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::array<char, 256> MakeDisplayCharacters() {
+  std::array<char, 256> table;
+  for (unsigned cell = 0; cell != table.size(); ++cell) {
+    table[cell] = ComputeDisplayCharacter(cell);
+  }
+  return table;
+}
+
+}  // namespace
+
+const std::array<char, 256> kCellDisplayCharacters = MakeDisplayCharacters();
+
+/*********************************************************************
+** Function: AsOpenSpace
+** Description: Returns a view of the location as an open space, if it is
+ * one.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Option<OpenSpace> MazeLocation::AsOpenSpace() const {
+  if (!occupiable()) return None;
+  return OpenSpace(level_, cell_, pos_);
+}
@@ -4,33 +4,90 @@
 ** Program Filename: MazeLocation.h
 ** Author: Jason Chen
 ** Date: 03/19/2018
-** Description: Declares the MazeLocation class and its related members. 
+** Description: Declares the MazeLocation class and its related members.
 ** Input: None
 ** Output: None
 *********************************************************************/
 
 
+#include <array>
+#include <cstdint>
 #include "MazePosition.h"
 
+// Every cell of a level is stored as a single byte; the low bit says whether
+// the cell is a wall, and the remaining bits are the flags of an open space.
+typedef std::uint8_t MazeCell;
+
+enum MazeCellFlag : MazeCell {
+  kCellWall = 1 << 0,
+  kCellBeginning = 1 << 1,
+  kCellLadder = 1 << 2,
+  kCellInstructor = 1 << 3,
+  kCellSkill = 1 << 4,
+  kCellStudent = 1 << 5,
+  kCellTa = 1 << 6,
+};
+
+// Number of distinct MazeCellFlag bits.
+const unsigned kNumCellFlags = 7;
+
+// Whether a cell is a wall or an open space is a property of the cell's value
+// (its wall bit), not of its C++ type, so every check is a mask and compare.
+enum class CellKind : MazeCell {
+  Open = 0,
+  Wall = kCellWall,
+};
+
+/*********************************************************************
+** Function: CellKindOf
+** Description: Returns whether the given cell is a wall or an open space.
+** Parameters: cell is the packed cell record.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+inline CellKind CellKindOf(MazeCell cell) {
+  return static_cast<CellKind>(cell & kCellWall);
+}
+
+// The display character of every possible cell value, indexed by the cell.
+extern const std::array<char, 256> kCellDisplayCharacters;
+
+/*********************************************************************
+** Function: CellDisplayCharacter
+** Description: Returns the display character for a cell in its current
+ * state.
+** Parameters: cell is the packed cell record.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+inline char CellDisplayCharacter(MazeCell cell) {
+  return kCellDisplayCharacters[cell];
+}
+
+class MazeLevel;
+class OpenSpace;
+
+// A MazeLocation is a lightweight view of one cell in a MazeLevel; it is only
+// valid for as long as the level it was taken from.
 class MazeLocation {
   public:
-    MazeLocation(MazePosition pos, bool occupiable): pos_(pos),
-        occupiable_(occupiable) {}
+    MazeLocation(MazeLevel* level, MazeCell* cell, MazePosition pos):
+        level_(level), cell_(cell), pos_(pos) {}
 
-    // Just in case.
-    virtual ~MazeLocation() = default;
-
-    // Abstract because the OpenSpace class changes its display character
-    // depending on what's on/in the space at any given time.
-    virtual char DisplayCharacter() const = 0;
+    char DisplayCharacter() const { return CellDisplayCharacter(*cell_); }
 
     MazePosition pos() const { return pos_; }
-    bool occupiable() const { return occupiable_; }
+    CellKind kind() const { return CellKindOf(*cell_); }
+    bool occupiable() const { return kind() == CellKind::Open; }
+
+    Option<OpenSpace> AsOpenSpace() const;
+
+  protected:
+    MazeLevel* level_;
+    MazeCell* cell_;
 
   private:
     MazePosition pos_;
-
-    bool occupiable_;
 };
 
 
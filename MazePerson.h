@@ -25,8 +25,8 @@ class MazePerson {
     GetMove(std::vector<PlayerAction> valid_moves) = 0;
 
     // What to do when the person enters/leaves the given space.
-    virtual void Occupy(OpenSpace* space) = 0;
-    virtual void Unoccupy(OpenSpace* space) = 0;
+    virtual void Occupy(OpenSpace space) = 0;
+    virtual void Unoccupy(OpenSpace space) = 0;
 
     MazePosition position() const { return position_; }
 
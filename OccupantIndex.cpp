@@ -0,0 +1,89 @@
+/*********************************************************************
+** Program Filename: OccupantIndex.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the OccupantIndex class.
+** Input: None
+** Output: None
+*********************************************************************/
+#include "OccupantIndex.h"
+
+const std::uint32_t OccupantIndex::kNone;
+
+/*********************************************************************
+** Function: First
+** Description: Returns an entity on the given cell, if there is one.
+** Parameters: cell is the cell's index on the level.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Option<unsigned> OccupantIndex::First(unsigned cell) const {
+  if (head_[cell] == kNone) return None;
+  return head_[cell];
+}
+
+/*********************************************************************
+** Function: Next
+** Description: Returns the entity after the given one on the same cell, if
+ * there is one.
+** Parameters: id is an entity in the index.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Option<unsigned> OccupantIndex::Next(unsigned id) const {
+  if (next_[id] == kNone) return None;
+  return next_[id];
+}
+
+/*********************************************************************
+** Function: Add
+** Description: Records that the given entity stands on the given cell.
+** Parameters: cell is the cell's index on the level; id is the entity.
+** Pre-Conditions: id is not already in the index.
+** Post-Conditions: None
+*********************************************************************/
+void OccupantIndex::Add(unsigned cell, unsigned id) {
+  if (id >= cell_of_.size()) {
+    next_.resize(id + 1, kNone);
+    cell_of_.resize(id + 1, kNone);
+  }
+
+  next_[id] = head_[cell];
+  cell_of_[id] = cell;
+  head_[cell] = id;
+}
+
+/*********************************************************************
+** Function: Remove
+** Description: Removes the given entity from the cell it stands on.
+** Parameters: id is the entity.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void OccupantIndex::Remove(unsigned id) {
+  if (id >= cell_of_.size() || cell_of_[id] == kNone) return;
+
+  std::uint32_t* link = &head_[cell_of_[id]];
+  while (*link != id) link = &next_[*link];
+  *link = next_[id];
+
+  next_[id] = kNone;
+  cell_of_[id] = kNone;
+}
+
+/*********************************************************************
+** Function: Clear
+** Description: Removes every entity; only touches the cells that are
+ * occupied, not the whole level.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void OccupantIndex::Clear() {
+  for (std::uint32_t cell : cell_of_) {
+    if (cell != kNone) head_[cell] = kNone;
+  }
+
+  next_.clear();
+  cell_of_.clear();
+}
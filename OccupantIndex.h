@@ -0,0 +1,50 @@
+#ifndef ESCAPEFROMCS162_OCCUPANTINDEX_H
+#define ESCAPEFROMCS162_OCCUPANTINDEX_H
+/*********************************************************************
+** Program Filename: OccupantIndex.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the OccupantIndex class and its related members.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstdint>
+#include <vector>
+#include "Option.h"
+
+// Maps each cell of a level to the entities (identified by small integer IDs,
+// e.g., a TA's index on its level) standing on it. Every operation is
+// constant time apart from walking the (rarely longer than one) chain of
+// entities that share a cell.
+class OccupantIndex {
+  public:
+    OccupantIndex() = default;
+    explicit OccupantIndex(unsigned cells): head_(cells, kNone) {}
+
+    bool Occupied(unsigned cell) const { return head_[cell] != kNone; }
+    Option<unsigned> First(unsigned cell) const;
+    // Returns the entity after id on the same cell, if any.
+    Option<unsigned> Next(unsigned id) const;
+
+    void Add(unsigned cell, unsigned id);
+    void Remove(unsigned id);
+    void Move(unsigned id, unsigned to) { Remove(id); Add(to, id); }
+    void Clear();
+
+    unsigned cells() const { return static_cast<unsigned>(head_.size()); }
+
+  private:
+    static const std::uint32_t kNone = UINT32_MAX;
+
+    // head_[cell] is the most recently added entity on the cell; next_[id] is
+    // the entity added before id on the same cell; cell_of_[id] is id's cell
+    // (kNone if id is not in the index).
+    std::vector<std::uint32_t> head_;
+    std::vector<std::uint32_t> next_;
+    std::vector<std::uint32_t> cell_of_;
+};
+
+
+#endif //ESCAPEFROMCS162_OCCUPANTINDEX_H
@@ -8,35 +8,15 @@
 ** Output: None
 *********************************************************************/
 #include "OpenSpace.h"
+#include "MazeLevel.h"
 
 /*********************************************************************
-** Function: IsEmpty
-** Description: Returns whether the space is empty, which is defined as having
- * no instructor, student, TA, ladder, or skill (primarily used for placing
- * things initially.
-** Parameters: None
+** Function: Set
+** Description: Sets or clears one of the space's flags.
+** Parameters: flag is the flag to change; value is its new value.
 ** Pre-Conditions: None
 ** Post-Conditions: None
 *********************************************************************/
-bool OpenSpace::IsEmpty() const {
-  return !has_instructor_ && !has_ladder_ && !has_student_ && !has_ta_
-      && !has_skill_ && !is_beginning_;
+void OpenSpace::Set(MazeCellFlag flag, bool value) {
+  level_->SetFlag(pos().row * level_->width() + pos().col, flag, value);
 }
-
-/*********************************************************************
-** Function: DisplayCharacter
-** Description: Returns the display character for the space in its current
- * state.
-** Parameters: None
-** Pre-Conditions: None
-** Post-Conditions: None
-*********************************************************************/
-char OpenSpace::DisplayCharacter() const {
-  if (has_student_) return '*';
-  else if (has_ta_) return 'T';
-  else if (has_skill_) return '$';
-  else if (is_beginning_) return '@';
-  else if (has_ladder_) return '^';
-  else if (has_instructor_) return '%';
-  else return ' ';
-}
\ No newline at end of file
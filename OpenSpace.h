@@ -4,7 +4,7 @@
 ** Program Filename: OpenSpace.h
 ** Author: Jason Chen
 ** Date: 03/19/2018
-** Description: Declares the OpenSpace class and its related members. 
+** Description: Declares the OpenSpace class and its related members.
 ** Input: None
 ** Output: None
 *********************************************************************/
@@ -12,36 +12,36 @@
 
 #include "MazeLocation.h"
 
+// A view of a cell that is known not to be a wall.
 class OpenSpace : public MazeLocation {
   public:
-    explicit OpenSpace(MazePosition pos): MazeLocation(pos, true) {}
+    OpenSpace(MazeLevel* level, MazeCell* cell, MazePosition pos):
+        MazeLocation(level, cell, pos) {}
 
-    bool IsEmpty() const;
-    char DisplayCharacter() const override;
+    bool IsEmpty() const { return *cell_ == 0; }
 
-    bool is_beginning() const { return is_beginning_; }
-    bool has_ladder() const { return has_ladder_; }
-    bool has_instructor() const { return has_instructor_; }
-    bool has_skill() const { return has_skill_; }
-    bool has_student() const { return has_student_; }
-    bool has_ta() const { return has_ta_; }
+    bool is_beginning() const { return Has(kCellBeginning); }
+    bool has_ladder() const { return Has(kCellLadder); }
+    bool has_instructor() const { return Has(kCellInstructor); }
+    bool has_skill() const { return Has(kCellSkill); }
+    bool has_student() const { return Has(kCellStudent); }
+    bool has_ta() const { return Has(kCellTa); }
 
-    void set_is_beginning(bool is_beginning) { is_beginning_ = is_beginning; }
-    void set_has_ladder(bool has_ladder) { has_ladder_ = has_ladder; }
+    void set_is_beginning(bool is_beginning) {
+      Set(kCellBeginning, is_beginning);
+    }
+    void set_has_ladder(bool has_ladder) { Set(kCellLadder, has_ladder); }
     void set_has_instructor(bool has_instructor) {
-      has_instructor_ = has_instructor;
+      Set(kCellInstructor, has_instructor);
     }
-    void set_has_skill(bool has_skill) { has_skill_ = has_skill; }
-    void set_has_student(bool has_student) { has_student_ = has_student; }
-    void set_has_ta(bool has_ta) { has_ta_ = has_ta; }
+    void set_has_skill(bool has_skill) { Set(kCellSkill, has_skill); }
+    void set_has_student(bool has_student) { Set(kCellStudent, has_student); }
+    void set_has_ta(bool has_ta) { Set(kCellTa, has_ta); }
 
   private:
-    bool is_beginning_ = false;
-    bool has_ladder_ = false;
-    bool has_instructor_ = false;
-    bool has_skill_ = false;
-    bool has_student_ = false;
-    bool has_ta_ = false;
+    bool Has(MazeCellFlag flag) const { return (*cell_ & flag) != 0; }
+    // Goes through the level so it can log the change.
+    void Set(MazeCellFlag flag, bool value);
 };
 
 
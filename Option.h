@@ -62,14 +62,17 @@ class Option {
     inline T& UnwrapRef();
     inline T& UnwrapRefOr(T& t);
 
-    template <typename E>
-    Option<E> AndThen(std::function<Option<E>(T)> f);
+    // The combinators take any callable (lambdas, function pointers,
+    // std::function, ...) as a template parameter, so lambdas are inlined
+    // instead of being wrapped in a type-erased std::function.
+    template <typename E, typename F>
+    Option<E> AndThen(F&& f);
 
-    template <typename E>
-    Option<E> Map(std::function<E(T)> f);
+    template <typename E, typename F>
+    Option<E> Map(F&& f);
 
-    template <typename E>
-    Option<E> MapCRef(std::function<E(const T&)> f) const;
+    template <typename E, typename F>
+    Option<E> MapCRef(F&& f) const;
 
     Option<T>& operator=(const Option<T>& rhs);
     Option<T>& operator=(Option<T>&& rhs);
@@ -230,8 +233,8 @@ T& Option<T>::UnwrapRefOr(T& t) {
 ** Post-Conditions:
 *********************************************************************/
 template <typename T>
-template <typename E>
-Option<E> Option<T>::AndThen(std::function<Option<E>(T)> f) {
+template <typename E, typename F>
+Option<E> Option<T>::AndThen(F&& f) {
   if (IsNone()) return None;
   moved_ = true;
   return f(std::move(value_));
@@ -247,8 +250,8 @@ Option<E> Option<T>::AndThen(std::function<Option<E>(T)> f) {
 ** Post-Conditions: None
 *********************************************************************/
 template <typename T>
-template <typename E>
-Option<E> Option<T>::Map(std::function<E(T)> f) {
+template <typename E, typename F>
+Option<E> Option<T>::Map(F&& f) {
   if (IsNone()) return None;
   moved_ = true;
   return f(std::move(value_));
@@ -264,8 +267,8 @@ Option<E> Option<T>::Map(std::function<E(T)> f) {
 ** Post-Conditions: None
 *********************************************************************/
 template <typename T>
-template <typename E>
-Option<E> Option<T>::MapCRef(std::function<E(const T&)> f) const {
+template <typename E, typename F>
+Option<E> Option<T>::MapCRef(F&& f) const {
   if (IsNone()) return None;
   return f(value_);
 }
@@ -335,6 +338,115 @@ void Option<T>::ThrowIfCannotUnwrap() const {
     throw BadOptionAccess("Cannot unwrap an empty Option.");
 }
 
+// Option<T*> uses the null pointer as its None state instead of separate
+// flags, so it is exactly the size of a pointer. A null pointer is therefore
+// always None, and unwrapping (moving) the pointer out leaves the Option
+// None.
+template <typename T>
+class Option<T*> {
+  public:
+    Option(): ptr_(nullptr) {}
+    Option(T* t): ptr_(t) {}
+    Option(const struct None&): Option() {}
+
+    bool IsNone() const { return ptr_ == nullptr; }
+    bool IsSome() const { return ptr_ != nullptr; }
+
+    explicit operator bool() const { return IsSome(); }
+
+    T* const& CUnwrapRef() const { ThrowIfCannotUnwrap(); return ptr_; }
+    T* const& CUnwrapRefOr(T* const& t) const { return IsNone() ? t : ptr_; }
+    T* Unwrap();
+    T* UnwrapOr(T* t) { return IsNone() ? t : Unwrap(); }
+    T*& UnwrapRef() { ThrowIfCannotUnwrap(); return ptr_; }
+    T*& UnwrapRefOr(T*& t) { return IsNone() ? t : ptr_; }
+
+    template <typename E, typename F>
+    Option<E> AndThen(F&& f);
+
+    template <typename E, typename F>
+    Option<E> Map(F&& f);
+
+    template <typename E, typename F>
+    Option<E> MapCRef(F&& f) const;
+
+  private:
+    T* ptr_;
+
+    void ThrowIfCannotUnwrap() const;
+};
+
+/*********************************************************************
+** Function: Unwrap
+** Description: Returns the pointer held by the optional and leaves the
+ * optional None; throws if the optional is None.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename T>
+T* Option<T*>::Unwrap() {
+  ThrowIfCannotUnwrap();
+  T* t = ptr_;
+  ptr_ = nullptr;
+  return t;
+}
+
+/*********************************************************************
+** Function: AndThen
+** Description: Same as Option<T>::AndThen, for pointers.
+** Parameters: f is a function (T* -> Option<E>).
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename T>
+template <typename E, typename F>
+Option<E> Option<T*>::AndThen(F&& f) {
+  if (IsNone()) return None;
+  return f(Unwrap());
+}
+
+/*********************************************************************
+** Function: Map
+** Description: Same as Option<T>::Map, for pointers.
+** Parameters: f is a function (T* -> E).
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename T>
+template <typename E, typename F>
+Option<E> Option<T*>::Map(F&& f) {
+  if (IsNone()) return None;
+  return f(Unwrap());
+}
+
+/*********************************************************************
+** Function: MapCRef
+** Description: Same as Option<T>::MapCRef, for pointers.
+** Parameters: f is a function (T* -> E).
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename T>
+template <typename E, typename F>
+Option<E> Option<T*>::MapCRef(F&& f) const {
+  if (IsNone()) return None;
+  return f(ptr_);
+}
+
+/*********************************************************************
+** Function: ThrowIfCannotUnwrap
+** Description: Throws an exception if called and no pointer is held.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename T>
+void Option<T*>::ThrowIfCannotUnwrap() const {
+  if (ptr_ == nullptr)
+    throw BadOptionAccess("Cannot unwrap an empty Option.");
+}
+
 /*********************************************************************
 ** Function: operator<<
 ** Description: Overloads the insertion operator to print Option<T> values.
@@ -0,0 +1,164 @@
+/*********************************************************************
+** Program Filename: OptionBench.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Microbenchmark for the Option combinators. Times a
+ * SpaceAt-style lookup chain (bounds check, then wall check, then map) built
+ * with the template combinators against the same chain built from
+ * std::function wrappers, and times Maze::SpaceAt itself.
+ * Usage: OptionBench [MAZE]
+ * To see what the chain compiles to, disassemble OpenCellAt:
+ *   objdump -d --no-show-raw-insn -C OptionBench | grep -A20 '<OpenCellAt'
+** Input: Optionally, the path to a maze data file.
+** Output: Nanoseconds per lookup for each variant.
+*********************************************************************/
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "Maze.h"
+
+// A bare grid of packed cells, so the chain is the only thing being timed.
+struct BenchGrid {
+  unsigned height;
+  unsigned width;
+  std::vector<MazeCell> cells;
+};
+
+/*********************************************************************
+** Function: CellIndexAt
+** Description: Returns the index of the cell at (row, col), if it is inside
+ * the grid.
+** Parameters: grid is the grid; row and col are the cell's coordinates.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+inline Option<unsigned> CellIndexAt(const BenchGrid& grid, unsigned row,
+    unsigned col) {
+  if (row >= grid.height || col >= grid.width) return None;
+  return row * grid.width + col;
+}
+
+/*********************************************************************
+** Function: OpenCellAt
+** Description: The SpaceAt-style chain built from the template combinators;
+ * kept out of line so its code can be inspected. It compiles down to the
+ * bounds check, one load of the cell, and the wall test.
+** Parameters: grid is the grid; row and col are the cell's coordinates.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+__attribute__((noinline))
+Option<const MazeCell*> OpenCellAt(const BenchGrid& grid, unsigned row,
+    unsigned col) {
+  return CellIndexAt(grid, row, col).AndThen<const MazeCell*>(
+      [&](unsigned i) {
+          const MazeCell* cell = &grid.cells[i];
+          return CellKindOf(*cell) == CellKind::Open
+              ? Option<const MazeCell*>(cell) : None;
+      });
+}
+
+/*********************************************************************
+** Function: FunctionAndThen
+** Description: AndThen as it was before the combinators became templates,
+ * i.e., going through a std::function.
+** Parameters: o is the option; f is the function to apply.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename T, typename E>
+Option<E> FunctionAndThen(Option<T> o, std::function<Option<E>(T)> f) {
+  if (o.IsNone()) return None;
+  return f(o.Unwrap());
+}
+
+/*********************************************************************
+** Function: OpenCellAtWithFunction
+** Description: Same as OpenCellAt, but through std::function.
+** Parameters: grid is the grid; row and col are the cell's coordinates.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+__attribute__((noinline))
+Option<const MazeCell*> OpenCellAtWithFunction(const BenchGrid& grid,
+    unsigned row, unsigned col) {
+  return FunctionAndThen<unsigned, const MazeCell*>(
+      CellIndexAt(grid, row, col),
+      [&](unsigned i) {
+          const MazeCell* cell = &grid.cells[i];
+          return CellKindOf(*cell) == CellKind::Open
+              ? Option<const MazeCell*>(cell) : None;
+      });
+}
+
+/*********************************************************************
+** Function: TimeLookups
+** Description: Calls lookup for every cell of a (height + 1) x (width + 1)
+ * area (so some lookups are out of bounds) until at least the given number
+ * of lookups have run; returns nanoseconds per lookup.
+** Parameters: height and width are the grid's size; min_lookups is the
+ * number of lookups to run; lookup returns whether the cell is open.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+template <typename F>
+double TimeLookups(unsigned height, unsigned width, unsigned long min_lookups,
+    F lookup) {
+  unsigned long lookups = 0;
+  unsigned long open = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  while (lookups < min_lookups) {
+    for (unsigned row = 0; row <= height; ++row) {
+      for (unsigned col = 0; col <= width; ++col) {
+        open += lookup(row, col);
+      }
+    }
+    lookups += static_cast<unsigned long>(height + 1) * (width + 1);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  // Keeps the compiler from discarding the lookups.
+  if (open == 1) std::cout << "";
+  return elapsed.count() / lookups;
+}
+
+int main(int argc, char** argv) {
+  const unsigned long kLookups = 50000000;
+
+  BenchGrid grid{512, 512, std::vector<MazeCell>(512 * 512)};
+  for (unsigned i = 0; i != grid.cells.size(); ++i) {
+    if (i % 3 == 0) grid.cells[i] = kCellWall;
+  }
+
+  std::cout << "sizeof(Option<unsigned>): " << sizeof(Option<unsigned>)
+            << ", sizeof(Option<TA*>): " << sizeof(Option<TA*>) << '\n';
+
+  std::cout << "Template combinators: "
+            << TimeLookups(grid.height, grid.width, kLookups,
+                   [&](unsigned r, unsigned c) {
+                       return OpenCellAt(grid, r, c).IsSome();
+                   })
+            << " ns/lookup\n";
+
+  std::cout << "std::function:        "
+            << TimeLookups(grid.height, grid.width, kLookups,
+                   [&](unsigned r, unsigned c) {
+                       return OpenCellAtWithFunction(grid, r, c).IsSome();
+                   })
+            << " ns/lookup\n";
+
+  if (argc >= 2) {
+    Maze maze(argv[1], 1, 0);
+    const MazeLevel& level = maze.levels().front();
+    std::cout << "Maze::SpaceAt:        "
+              << TimeLookups(level.height(), level.width(), kLookups / 10,
+                     [&](unsigned r, unsigned c) {
+                         return maze.SpaceAt(MazePosition{0, r, c}).IsSome();
+                     })
+              << " ns/lookup\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*********************************************************************
+** Program Filename: Parallel.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared in the Parallel header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Parallel.h"
+
+/*********************************************************************
+** Function: DefaultThreadCount
+** Description: Returns the number of threads the hardware can run at once
+ * (at least one).
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+unsigned DefaultThreadCount() {
+  unsigned n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+
+/*********************************************************************
+** Function: ParallelFor
+** Description: Calls body(i) for every i in [0, count), spreading the calls
+ * over a pool of worker threads that each take the next unclaimed index. With
+ * one thread (or one item), everything runs in order on the calling thread.
+ * If any call throws, the remaining indices are skipped and the first
+ * exception is rethrown once every worker has finished.
+** Parameters: count is the number of items; threads is the maximum number of
+ * threads to use; body is the work for a single item.
+** Pre-Conditions: Calls to body for different indices must be independent.
+** Post-Conditions: None
+*********************************************************************/
+void ParallelFor(unsigned long count, unsigned threads,
+    const std::function<void(unsigned long)>& body) {
+  if (threads <= 1 || count <= 1) {
+    for (unsigned long i = 0; i != count; ++i) body(i);
+    return;
+  }
+
+  std::atomic<unsigned long> next(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto worker = [&]() {
+      for (;;) {
+        unsigned long i = next.fetch_add(1);
+        if (i >= count || failed.load()) return;
+
+        try {
+          body(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          if (!error) error = std::current_exception();
+          failed.store(true);
+        }
+      }
+  };
+
+  unsigned long n = threads < count ? threads : count;
+  std::vector<std::thread> pool;
+  pool.reserve(n - 1);
+  for (unsigned long t = 1; t < n; ++t) pool.emplace_back(worker);
+
+  // The calling thread does its share of the work, too.
+  worker();
+  for (auto& t : pool) t.join();
+
+  if (error) std::rethrow_exception(error);
+}
@@ -0,0 +1,22 @@
+#ifndef ESCAPEFROMCS162_PARALLEL_H
+#define ESCAPEFROMCS162_PARALLEL_H
+/*********************************************************************
+** Program Filename: Parallel.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares helpers for running independent pieces of work on
+ * multiple threads.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <functional>
+
+unsigned DefaultThreadCount();
+
+void ParallelFor(unsigned long count, unsigned threads,
+    const std::function<void(unsigned long)>& body);
+
+
+#endif //ESCAPEFROMCS162_PARALLEL_H
@@ -0,0 +1,306 @@
+/*********************************************************************
+** Program Filename: Pathfinder.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the Pathfinder classes.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <algorithm>
+#include "Pathfinder.h"
+
+const std::uint32_t Pathfinder::kNoNode;
+
+namespace {
+
+/*********************************************************************
+** Function: IsHorizontal
+** Description: Returns whether a direction moves along a row.
+** Parameters: dir is the direction.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+bool IsHorizontal(PlayerDirectionAction dir) {
+  return dir == PlayerDirectionAction::Left ||
+         dir == PlayerDirectionAction::Right;
+}
+
+}  // namespace
+
+/*********************************************************************
+** Function: Pathfinder
+** Description: Constructor for the Pathfinder class; sizes the search state
+ * to the level.
+** Parameters: level is the level to search.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Pathfinder::Pathfinder(const MazeLevel& level):
+    level_(level),
+    stamp_(static_cast<std::size_t>(level.height()) * level.width(), 0),
+    g_(stamp_.size()), parent_(stamp_.size()) {}
+
+/*********************************************************************
+** Function: FindPath
+** Description: Returns a shortest path between two cells.
+** Parameters: from and to are the indices of the path's first and last cells.
+** Pre-Conditions: Both cells are open.
+** Post-Conditions: Returns the index of every cell on the path, in order, or
+ * None if there is no path.
+*********************************************************************/
+Option<std::vector<unsigned>> Pathfinder::FindPath(unsigned from,
+    unsigned to) {
+  if (!Search(from, to)) return None;
+
+  // Consecutive nodes are on the same row or column; fill in the cells
+  // between them while walking back from the goal.
+  std::vector<unsigned> path;
+  path.reserve(g_[to] + 1);
+  path.push_back(to);
+  for (unsigned node = to; node != from; node = parent_[node]) {
+    unsigned prev = parent_[node];
+    int step = prev / level_.width() == node / level_.width()
+        ? (prev < node ? -1 : 1)
+        : (prev < node ? -static_cast<int>(level_.width())
+                       : static_cast<int>(level_.width()));
+    for (unsigned index = node; index != prev; ) {
+      index += step;
+      path.push_back(index);
+    }
+  }
+
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+/*********************************************************************
+** Function: Distance
+** Description: Returns the number of moves on a shortest path between two
+ * cells.
+** Parameters: from and to are the indices of the cells.
+** Pre-Conditions: Both cells are open.
+** Post-Conditions: Returns None if there is no path.
+*********************************************************************/
+Option<unsigned> Pathfinder::Distance(unsigned from, unsigned to) {
+  if (!Search(from, to)) return None;
+  return g_[to];
+}
+
+/*********************************************************************
+** Function: Search
+** Description: Runs the A* search from one cell to another.
+** Parameters: from and to are the indices of the cells.
+** Pre-Conditions: Both cells are open.
+** Post-Conditions: Returns whether to was reached; if so, g_ and parent_
+ * describe a shortest path back to from.
+*********************************************************************/
+bool Pathfinder::Search(unsigned from, unsigned to) {
+  // Stamps must never repeat a value left over from an earlier query.
+  if (search_ == UINT32_MAX / 2) {
+    std::fill(stamp_.begin(), stamp_.end(), 0);
+    search_ = 0;
+  }
+  ++search_;
+
+  goal_ = to;
+  expanded_ = 0;
+  open_.clear();
+  Relax(from, from, 0);
+
+  while (!open_.empty()) {
+    std::pop_heap(open_.begin(), open_.end(), OpenerThan);
+    OpenNode top = open_.back();
+    open_.pop_back();
+
+    unsigned node = top.index;
+    if (stamp_[node] != 2 * search_ || top.g != g_[node]) continue;
+    stamp_[node] = 2 * search_ + 1;
+
+    if (node == to) return true;
+    ++expanded_;
+    ExpandNode(node);
+  }
+
+  return false;
+}
+
+/*********************************************************************
+** Function: Relax
+** Description: Records a path to a node if it is shorter than any found so
+ * far, and adds the node to the open list.
+** Parameters: node is the node reached; parent is the node it was reached
+ * from; g is the length of the path to it.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void Pathfinder::Relax(unsigned node, unsigned parent, std::uint32_t g) {
+  // With a consistent heuristic, a closed node already has its shortest path.
+  if (stamp_[node] == 2 * search_ + 1) return;
+  if (stamp_[node] == 2 * search_ && g_[node] <= g) return;
+
+  stamp_[node] = 2 * search_;
+  g_[node] = g;
+  parent_[node] = parent;
+  open_.push_back(OpenNode{g + ManhattanDistance(node, goal_), g, node});
+  std::push_heap(open_.begin(), open_.end(), OpenerThan);
+}
+
+/*********************************************************************
+** Function: ManhattanDistance
+** Description: Returns the number of moves between two cells if there were
+ * no walls.
+** Parameters: a and b are the indices of the cells.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+unsigned Pathfinder::ManhattanDistance(unsigned a, unsigned b) const {
+  unsigned width = level_.width();
+  unsigned ar = a / width, ac = a % width;
+  unsigned br = b / width, bc = b % width;
+  return (ar > br ? ar - br : br - ar) + (ac > bc ? ac - bc : bc - ac);
+}
+
+/*********************************************************************
+** Function: OpenerThan
+** Description: Orders the open list for std::push_heap and std::pop_heap,
+ * so the node with the lowest f comes out first and, among equal f, the one
+ * furthest along its path.
+** Parameters: a and b are open list entries.
+** Pre-Conditions: None
+** Post-Conditions: Returns whether a should come out after b.
+*********************************************************************/
+bool Pathfinder::OpenerThan(const OpenNode& a, const OpenNode& b) {
+  return a.f > b.f || (a.f == b.f && a.g < b.g);
+}
+
+/*********************************************************************
+** Function: ExpandNode
+** Description: Adds every open neighbor of a node to the open list.
+** Parameters: node is the node's index.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void AStarPathfinder::ExpandNode(unsigned node) {
+  for (unsigned mask = level_.MoveMaskAt(node); mask != 0; mask &= mask - 1) {
+    auto dir = static_cast<PlayerDirectionAction>(__builtin_ctz(mask));
+    Relax(level_.NeighborIndex(node, dir), node, g(node) + 1);
+  }
+}
+
+/*********************************************************************
+** Function: ExpandNode
+** Description: Adds the jump point in every direction a canonical path may
+ * leave a node in to the open list.
+** Parameters: node is the node's index.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void JumpPointPathfinder::ExpandNode(unsigned node) {
+  unsigned mask = level_.MoveMaskAt(node);
+  unsigned from = parent(node);
+
+  if (from != node) {
+    unsigned width = level_.width();
+    PlayerDirectionAction arrived =
+        from / width == node / width
+            ? (from < node ? PlayerDirectionAction::Right
+                           : PlayerDirectionAction::Left)
+            : (from < node ? PlayerDirectionAction::Down
+                           : PlayerDirectionAction::Up);
+
+    // Never turn back; after a vertical move, only keep going or turn into a
+    // forced neighbor.
+    if (IsHorizontal(arrived)) {
+      PlayerDirectionAction back = arrived == PlayerDirectionAction::Right
+          ? PlayerDirectionAction::Left : PlayerDirectionAction::Right;
+      mask &= ~DirectionBit(back);
+    } else {
+      unsigned prev = level_.NeighborIndex(node,
+          arrived == PlayerDirectionAction::Down ? PlayerDirectionAction::Up
+                                                 : PlayerDirectionAction::Down);
+      unsigned forced = mask & ~level_.MoveMaskAt(prev) &
+          (DirectionBit(PlayerDirectionAction::Left) |
+           DirectionBit(PlayerDirectionAction::Right));
+      mask = (mask & DirectionBit(arrived)) | forced;
+    }
+  }
+
+  for (; mask != 0; mask &= mask - 1) {
+    auto dir = static_cast<PlayerDirectionAction>(__builtin_ctz(mask));
+    unsigned jump_point = Jump(node, dir);
+    if (jump_point != kNoNode) {
+      Relax(jump_point, node,
+            g(node) + ManhattanDistance(node, jump_point));
+    }
+  }
+}
+
+/*********************************************************************
+** Function: Jump
+** Description: Returns the next jump point in a direction.
+** Parameters: index is the cell to move from; dir is the direction.
+** Pre-Conditions: The student can move from index in dir.
+** Post-Conditions: Returns kNoNode if the run ends at a wall first.
+*********************************************************************/
+unsigned JumpPointPathfinder::Jump(unsigned index,
+    PlayerDirectionAction dir) const {
+  return IsHorizontal(dir) ? JumpHorizontally(index, dir)
+                           : JumpVertically(index, dir);
+}
+
+/*********************************************************************
+** Function: JumpHorizontally
+** Description: Moves along a row until reaching the goal or a cell from which
+ * a vertical run finds a jump point.
+** Parameters: index is the cell to move from; dir is Left or Right.
+** Pre-Conditions: None
+** Post-Conditions: Returns kNoNode if the row ends at a wall first.
+*********************************************************************/
+unsigned JumpPointPathfinder::JumpHorizontally(unsigned index,
+    PlayerDirectionAction dir) const {
+  while (level_.CanMove(index, dir)) {
+    index = level_.NeighborIndex(index, dir);
+    if (index == goal_) return index;
+
+    if ((level_.CanMove(index, PlayerDirectionAction::Up) &&
+         JumpVertically(index, PlayerDirectionAction::Up) != kNoNode) ||
+        (level_.CanMove(index, PlayerDirectionAction::Down) &&
+         JumpVertically(index, PlayerDirectionAction::Down) != kNoNode)) {
+      return index;
+    }
+  }
+  return kNoNode;
+}
+
+/*********************************************************************
+** Function: JumpVertically
+** Description: Moves along a column until reaching the goal or a cell with a
+ * forced neighbor.
+** Parameters: index is the cell to move from; dir is Up or Down.
+** Pre-Conditions: None
+** Post-Conditions: Returns kNoNode if the column ends at a wall first.
+*********************************************************************/
+unsigned JumpPointPathfinder::JumpVertically(unsigned index,
+    PlayerDirectionAction dir) const {
+  while (level_.CanMove(index, dir)) {
+    unsigned prev = index;
+    index = level_.NeighborIndex(index, dir);
+    if (index == goal_ || HasForcedNeighbor(prev, index)) return index;
+  }
+  return kNoNode;
+}
+
+/*********************************************************************
+** Function: HasForcedNeighbor
+** Description: Returns whether a cell reached by a vertical move has a side
+ * cell that no canonical path could have reached by moving sideways first.
+** Parameters: prev is the cell moved from; index is the cell moved to.
+** Pre-Conditions: prev and index are vertical neighbors.
+** Post-Conditions: None
+*********************************************************************/
+bool JumpPointPathfinder::HasForcedNeighbor(unsigned prev,
+    unsigned index) const {
+  const unsigned sides = DirectionBit(PlayerDirectionAction::Left) |
+                         DirectionBit(PlayerDirectionAction::Right);
+  return (level_.MoveMaskAt(index) & ~level_.MoveMaskAt(prev) & sides) != 0;
+}
@@ -0,0 +1,105 @@
+#ifndef ESCAPEFROMCS162_PATHFINDER_H
+#define ESCAPEFROMCS162_PATHFINDER_H
+/*********************************************************************
+** Program Filename: Pathfinder.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the Pathfinder classes, which find shortest paths
+ * between two cells of a level.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstdint>
+#include <vector>
+#include "MazeLevel.h"
+
+// Finds shortest paths between two cells of a level, moving the way the
+// student does, with an A* search under the Manhattan distance. Subclasses
+// decide which nodes each expanded node leads to; the queries are the same
+// for all of them. The search state is sized to the level once and stamped
+// per query, so a query only touches the cells it visits. A pathfinder reads
+// only the level's walls, which never change, so it stays valid for the
+// level's lifetime.
+class Pathfinder {
+  public:
+    explicit Pathfinder(const MazeLevel& level);
+    // Just in case.
+    virtual ~Pathfinder() = default;
+
+    // The path includes both from and to; both must be open cells.
+    Option<std::vector<unsigned>> FindPath(unsigned from, unsigned to);
+    Option<unsigned> Distance(unsigned from, unsigned to);
+
+    // The number of nodes the last query expanded.
+    unsigned long expanded() const { return expanded_; }
+
+  protected:
+    static const std::uint32_t kNoNode = UINT32_MAX;
+
+    const MazeLevel& level_;
+    unsigned goal_ = 0;
+
+    virtual void ExpandNode(unsigned node) = 0;
+
+    void Relax(unsigned node, unsigned parent, std::uint32_t g);
+    std::uint32_t g(unsigned node) const { return g_[node]; }
+    unsigned parent(unsigned node) const { return parent_[node]; }
+    unsigned ManhattanDistance(unsigned a, unsigned b) const;
+
+  private:
+    struct OpenNode {
+      std::uint32_t f;
+      std::uint32_t g;
+      unsigned index;
+    };
+
+    // A node is open if stamp_ is 2 * search_, and closed if it is one more;
+    // anything else is left over from an earlier query.
+    std::vector<std::uint32_t> stamp_;
+    std::vector<std::uint32_t> g_;
+    std::vector<std::uint32_t> parent_;
+    std::uint32_t search_ = 0;
+    // A binary heap ordered by OpenerThan; stale entries are skipped when
+    // popped rather than removed when a node's g improves.
+    std::vector<OpenNode> open_;
+    unsigned long expanded_ = 0;
+
+    bool Search(unsigned from, unsigned to);
+    static bool OpenerThan(const OpenNode& a, const OpenNode& b);
+};
+
+// Expands every open neighbor of every node: plain A*.
+class AStarPathfinder : public Pathfinder {
+  public:
+    explicit AStarPathfinder(const MazeLevel& level): Pathfinder(level) {}
+
+  protected:
+    void ExpandNode(unsigned node) override;
+};
+
+// Jump point search for 4-connected grids. Of all the shortest paths between
+// two cells, it only follows those that make their horizontal moves as early
+// as possible, so a search runs straight through open space and only adds
+// the cells where such a path has to turn (jump points) to the open list.
+// Moving vertically, a side cell is only worth turning into (forced) if the
+// cell beside the previous one is a wall, since otherwise the path could have
+// moved sideways first; moving horizontally, a cell is a jump point if a
+// vertical run from it reaches a forced turn or the goal.
+class JumpPointPathfinder : public Pathfinder {
+  public:
+    explicit JumpPointPathfinder(const MazeLevel& level): Pathfinder(level) {}
+
+  protected:
+    void ExpandNode(unsigned node) override;
+
+  private:
+    unsigned Jump(unsigned index, PlayerDirectionAction dir) const;
+    unsigned JumpHorizontally(unsigned index, PlayerDirectionAction dir) const;
+    unsigned JumpVertically(unsigned index, PlayerDirectionAction dir) const;
+    bool HasForcedNeighbor(unsigned prev, unsigned index) const;
+};
+
+
+#endif //ESCAPEFROMCS162_PATHFINDER_H
@@ -45,6 +45,15 @@ enum class PlayerDirectionAction {
     Right,
 };
 
+// Number of PlayerDirectionAction values.
+const unsigned kNumPlayerDirections = 4;
+
+// Each direction owns one bit of a move mask, in declaration order (Up is bit
+// 0); a cell's move mask has a direction's bit set if that move is legal.
+inline unsigned DirectionBit(PlayerDirectionAction dir) {
+  return 1u << static_cast<unsigned>(dir);
+}
+
 // Macro to help easily specialize ActionInput for default actions.
 #define ESC162_SPECIALIZE_ACTION_STRING(I, T) \
 template <> struct ActionInput<I, T> { \
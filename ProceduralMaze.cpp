@@ -0,0 +1,460 @@
+/*********************************************************************
+** Program Filename: ProceduralMaze.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the ProceduralLevel class
+ * and in the ProceduralMaze header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+#include "ProceduralMaze.h"
+
+namespace {
+
+// How much of a level each thread generates before writing it out.
+const std::size_t kChunkBytes = 1 << 20;
+
+/*********************************************************************
+** Function: ChanceThreshold
+** Description: Converts a probability to a threshold for
+ * ProceduralLevel::Chance.
+** Parameters: p is the probability.
+** Pre-Conditions: 0 <= p <= 1
+** Post-Conditions: None
+*********************************************************************/
+std::uint64_t ChanceThreshold(double p) {
+  return static_cast<std::uint64_t>(p * 4294967296.0);
+}
+
+/*********************************************************************
+** Function: CheckOptions
+** Description: Throws if the options can't produce a valid maze.
+** Parameters: opts are the options to check.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void CheckOptions(const ProceduralMazeOptions& opts) {
+  // A 5 x 5 level has four corridor cells and three passages: room for the
+  // beginning, the ladder, two TAs, and three skills.
+  if (opts.levels < 1 || opts.height < 5 || opts.width < 5) {
+    throw std::runtime_error(
+        "Levels must be >= 1, and height and width must be >= 5.");
+  }
+  if (opts.levels > INT_MAX || opts.height > INT_MAX || opts.width > INT_MAX ||
+      static_cast<std::uint64_t>(opts.height) * opts.width > UINT_MAX) {
+    throw std::runtime_error("The maze is too large for a level to index.");
+  }
+  if (!(opts.rooms >= 0 && opts.rooms <= 1) ||
+      !(opts.loops >= 0 && opts.loops <= 1)) {
+    throw std::runtime_error("Room and loop fractions must be in [0, 1].");
+  }
+  if (opts.room_size < 3) {
+    throw std::runtime_error("The room size must be >= 3.");
+  }
+}
+
+/*********************************************************************
+** Function: WriteAt
+** Description: Writes bytes at an offset of a file, repeating the write if
+ * the kernel takes part of them at a time.
+** Parameters: fd is the file; data points to the bytes; n is how many there
+ * are; offset is where they go; path names the file in errors.
+** Pre-Conditions: None
+** Post-Conditions: Throws if the write fails.
+*********************************************************************/
+void WriteAt(int fd, const char* data, std::size_t n, std::uint64_t offset,
+    const std::string& path) {
+  while (n != 0) {
+    ssize_t written = pwrite(fd, data, n, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Unable to write " + path + ": " +
+                               std::strerror(errno));
+    }
+    data += written;
+    n -= static_cast<std::size_t>(written);
+    offset += static_cast<std::uint64_t>(written);
+  }
+}
+
+/*********************************************************************
+** Function: MazeHeader
+** Description: Returns the first line of a maze data file.
+** Parameters: opts are the generator's options.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::string MazeHeader(const ProceduralMazeOptions& opts) {
+  return std::to_string(opts.levels) + ' ' + std::to_string(opts.height) +
+         ' ' + std::to_string(opts.width) + '\n';
+}
+
+}  // namespace
+
+/*********************************************************************
+** Function: ProceduralLevel
+** Description: Constructor for the ProceduralLevel class; picks where the
+ * beginning and the ladder go and starts the first row's sets.
+** Parameters: opts are the generator's options; level is the level's number.
+** Pre-Conditions: opts have been checked by CheckOptions, and level <
+ * opts.levels.
+** Post-Conditions: None
+*********************************************************************/
+ProceduralLevel::ProceduralLevel(const ProceduralMazeOptions& opts,
+    unsigned level):
+    height_(opts.height), width_(opts.width), room_size_(opts.room_size),
+    cell_rows_((opts.height - 1) / 2), cell_cols_((opts.width - 1) / 2),
+    loop_chance_(ChanceThreshold(opts.loops)),
+    rng_(Rng::ForStream(opts.seed, level)),
+    exit_glyph_(level + 1 == opts.levels ? '%' : '^'),
+    set_(cell_cols_), parent_(cell_cols_), root_(cell_cols_),
+    right_(cell_cols_), down_(cell_cols_), has_down_(cell_cols_),
+    candidate_(cell_cols_), free_labels_(cell_cols_) {
+  // A room started at a corridor cell covers about side * side cells of the
+  // level, and there is a corridor cell for every four.
+  double side = (3 + opts.room_size) / 2.0;
+  room_chance_ = ChanceThreshold(std::min(1.0, opts.rooms * 4 / (side * side)));
+
+  std::uint64_t cells = static_cast<std::uint64_t>(cell_rows_) * cell_cols_;
+  start_ = rng_.Below(cells);
+  exit_ = rng_.Below(cells - 1);
+  if (exit_ >= start_) ++exit_;
+
+  for (unsigned c = 0; c != cell_cols_; ++c) set_[c] = c;
+}
+
+/*********************************************************************
+** Function: NextRow
+** Description: Generates the next row of the level.
+** Parameters: out is where the row goes.
+** Pre-Conditions: out has room for width + 1 characters, and fewer than
+ * height rows have been generated.
+** Post-Conditions: out holds the row and a newline.
+*********************************************************************/
+void ProceduralLevel::NextRow(char* out) {
+  const unsigned row = row_++;
+  std::memset(out, '#', width_);
+  out[width_] = '\n';
+
+  // Rows 2k + 1 hold the corridor cells of cell row k and the passages
+  // between them; rows 2k + 2 hold the passages down to cell row k + 1.
+  // Anything past the last cell row (or column) stays wall.
+  const unsigned cell_row = row / 2;
+  const bool is_cell_row = row % 2 == 1 && cell_row < cell_rows_;
+  if (is_cell_row) {
+    JoinRow(cell_row + 1 == cell_rows_);
+    for (unsigned c = 0; c != cell_cols_; ++c) {
+      out[2 * c + 1] = ' ';
+      out[2 * c + 2] = right_[c] ? ' ' : '#';
+    }
+    StartRooms(row);
+  } else if (row % 2 == 0 && row != 0 && cell_row < cell_rows_) {
+    for (unsigned c = 0; c != cell_cols_; ++c) {
+      out[2 * c + 1] = down_[c] ? ' ' : '#';
+    }
+    CarryDown();
+  }
+
+  DrawRooms(out, row);
+
+  if (is_cell_row) {
+    if (start_ / cell_cols_ == cell_row) {
+      out[2 * (start_ % cell_cols_) + 1] = '@';
+    }
+    if (exit_ / cell_cols_ == cell_row) {
+      out[2 * (exit_ % cell_cols_) + 1] = exit_glyph_;
+    }
+  }
+}
+
+/*********************************************************************
+** Function: Chance
+** Description: Returns true with the probability a threshold stands for.
+** Parameters: threshold is the probability, as returned by ChanceThreshold.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+bool ProceduralLevel::Chance(std::uint64_t threshold) {
+  return (rng_.Next() >> 32) < threshold;
+}
+
+/*********************************************************************
+** Function: Coin
+** Description: Returns true or false with equal probability, using one bit
+ * of a random word at a time.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+bool ProceduralLevel::Coin() {
+  if (coin_bits_ == 0) {
+    coins_ = rng_.Next();
+    coin_bits_ = 64;
+  }
+  bool heads = coins_ & 1;
+  coins_ >>= 1;
+  --coin_bits_;
+  return heads;
+}
+
+/*********************************************************************
+** Function: Find
+** Description: Returns the label a set label has been joined into, halving
+ * the path to it along the way.
+** Parameters: label is the label to look up.
+** Pre-Conditions: label < cell_cols_
+** Post-Conditions: None
+*********************************************************************/
+unsigned ProceduralLevel::Find(unsigned label) {
+  while (parent_[label] != label) {
+    parent_[label] = parent_[parent_[label]];
+    label = parent_[label];
+  }
+  return label;
+}
+
+/*********************************************************************
+** Function: JoinRow
+** Description: Chooses which cells of the current row open to their right
+ * neighbour, joining their sets, and which open down, with every set
+ * opening down at least once so none of it is cut off.
+** Parameters: last is whether this is the last cell row, which joins every
+ * set that is left and opens nothing down.
+** Pre-Conditions: set_ holds the row's labels.
+** Post-Conditions: right_, down_, and root_ describe the row.
+*********************************************************************/
+void ProceduralLevel::JoinRow(bool last) {
+  for (unsigned c = 0; c != cell_cols_; ++c) parent_[c] = c;
+
+  // Joining a cell's set into its right neighbour's keeps the neighbour's
+  // root, so each cell's root is found once. Both choices are drawn for every
+  // pair and then selected between, since which one applies is a coin flip.
+  unsigned a = Find(set_[0]);
+  for (unsigned c = 0; c + 1 < cell_cols_; ++c) {
+    unsigned b = Find(set_[c + 1]);
+    bool join = last || Coin();
+    bool loop = loop_chance_ != 0 && Chance(loop_chance_);
+    bool open = a != b ? join : loop;
+    parent_[a] = open ? b : a;
+    right_[c] = open;
+    a = b;
+  }
+
+  if (last) {
+    std::fill(down_.begin(), down_.end(), 0);
+    return;
+  }
+
+  for (unsigned c = 0; c != cell_cols_; ++c) {
+    root_[c] = Find(set_[c]);
+    has_down_[root_[c]] = 0;
+  }
+
+  // Each set also remembers its last cell, to open down in case none of its
+  // cells does by chance.
+  for (unsigned c = 0; c != cell_cols_; ++c) {
+    unsigned root = root_[c];
+    down_[c] = Coin();
+    has_down_[root] |= down_[c];
+    candidate_[root] = c;
+  }
+
+  for (unsigned c = 0; c != cell_cols_; ++c) {
+    unsigned root = root_[c];
+    down_[c] |= !has_down_[root] && candidate_[root] == c;
+  }
+}
+
+/*********************************************************************
+** Function: CarryDown
+** Description: Labels the next row's cells: those opened down from the
+ * current row keep their set, and the rest each start a new one.
+** Parameters: None
+** Pre-Conditions: JoinRow has chosen the current row's downward passages.
+** Post-Conditions: set_ holds the next row's labels.
+*********************************************************************/
+void ProceduralLevel::CarryDown() {
+  // has_down_ is reused to mark the labels that are taken. The loops below
+  // select rather than branch, since down_ is a coin flip per cell.
+  std::fill(has_down_.begin(), has_down_.end(), 0);
+  for (unsigned c = 0; c != cell_cols_; ++c) {
+    has_down_[root_[c]] |= down_[c];
+  }
+
+  unsigned free = 0;
+  for (unsigned label = 0; label != cell_cols_; ++label) {
+    free_labels_[free] = label;
+    free += !has_down_[label];
+  }
+
+  unsigned next = 0;
+  for (unsigned c = 0; c != cell_cols_; ++c) {
+    set_[c] = down_[c] ? root_[c] : free_labels_[next];
+    next += !down_[c];
+  }
+}
+
+/*********************************************************************
+** Function: StartRooms
+** Description: Randomly starts rooms at the corridor cells of a row.
+** Parameters: row is the row of the level.
+** Pre-Conditions: row holds corridor cells.
+** Post-Conditions: None
+*********************************************************************/
+void ProceduralLevel::StartRooms(unsigned row) {
+  if (room_chance_ == 0) return;
+
+  for (unsigned c = 0; c != cell_cols_; ++c) {
+    if (!Chance(room_chance_)) continue;
+
+    // Rooms stay inside the border.
+    unsigned left = 2 * c + 1;
+    unsigned rows = 3 + static_cast<unsigned>(rng_.Below(room_size_ - 2));
+    unsigned cols = 3 + static_cast<unsigned>(rng_.Below(room_size_ - 2));
+    rooms_.push_back({row, std::min(row + rows - 1, height_ - 2),
+                      left, std::min(left + cols - 1, width_ - 2)});
+  }
+}
+
+/*********************************************************************
+** Function: DrawRooms
+** Description: Opens the part of a row covered by rooms, and forgets the
+ * rooms that end there.
+** Parameters: out is the row; row is its number.
+** Pre-Conditions: Every room started so far covers row.
+** Post-Conditions: None
+*********************************************************************/
+void ProceduralLevel::DrawRooms(char* out, unsigned row) {
+  for (const Room& room : rooms_) {
+    std::memset(out + room.left, ' ', room.right - room.left + 1);
+  }
+
+  rooms_.erase(std::remove_if(rooms_.begin(), rooms_.end(),
+      [row](const Room& room) { return room.bottom == row; }), rooms_.end());
+}
+
+/*********************************************************************
+** Function: WriteProceduralMaze
+** Description: Writes a maze data file of procedurally generated levels,
+ * generating and writing the levels in parallel.
+** Parameters: path is the file to write; opts are the generator's options.
+** Pre-Conditions: None
+** Post-Conditions: Returns the size of the file; throws if the options are
+ * invalid or the file can't be written.
+*********************************************************************/
+std::uint64_t WriteProceduralMaze(const std::string& path,
+    const ProceduralMazeOptions& opts) {
+  CheckOptions(opts);
+
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("Unable to open " + path + ": " +
+                             std::strerror(errno));
+  }
+
+  const std::string header = MazeHeader(opts);
+  const std::size_t row_size = static_cast<std::size_t>(opts.width) + 1;
+  const std::uint64_t level_size =
+      static_cast<std::uint64_t>(opts.height) * row_size;
+  const std::uint64_t total = header.size() + opts.levels * level_size;
+
+  try {
+    // Sizing the file first lets every level be written at its own offset,
+    // in whatever order the threads finish them.
+    if (ftruncate(fd, static_cast<off_t>(total)) != 0) {
+      throw std::runtime_error("Unable to size " + path + ": " +
+                               std::strerror(errno));
+    }
+    WriteAt(fd, header.data(), header.size(), 0, path);
+
+    const std::size_t chunk_rows = std::max<std::size_t>(
+        1, std::min<std::size_t>(kChunkBytes / row_size, opts.height));
+    ParallelFor(opts.levels, opts.threads, [&](unsigned long i) {
+        ProceduralLevel level(opts, static_cast<unsigned>(i));
+        std::vector<char> chunk(chunk_rows * row_size);
+        std::uint64_t offset = header.size() + i * level_size;
+
+        for (unsigned row = 0; row != opts.height; ) {
+          std::size_t rows = 0;
+          for (; rows != chunk_rows && row != opts.height; ++rows, ++row) {
+            level.NextRow(&chunk[rows * row_size]);
+          }
+          WriteAt(fd, chunk.data(), rows * row_size, offset, path);
+          offset += rows * row_size;
+        }
+    });
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+
+  if (close(fd) != 0) {
+    throw std::runtime_error("Unable to write " + path + ": " +
+                             std::strerror(errno));
+  }
+  return total;
+}
+
+/*********************************************************************
+** Function: WriteTemporaryProceduralMaze
+** Description: Writes a maze data file of procedurally generated levels to
+ * a new temporary file.
+** Parameters: opts are the generator's options.
+** Pre-Conditions: None
+** Post-Conditions: Returns the path of the file; throws if the options are
+ * invalid or the file can't be written.
+*********************************************************************/
+std::string WriteTemporaryProceduralMaze(const ProceduralMazeOptions& opts) {
+  const char* tmpdir = std::getenv("TMPDIR");
+  std::string path = std::string(tmpdir != nullptr ? tmpdir : "/tmp") +
+                     "/cs162-maze-XXXXXX";
+
+  int fd = mkstemp(&path[0]);
+  if (fd < 0) {
+    throw std::runtime_error("Unable to create " + path + ": " +
+                             std::strerror(errno));
+  }
+  close(fd);
+
+  try {
+    WriteProceduralMaze(path, opts);
+  } catch (...) {
+    unlink(path.c_str());
+    throw;
+  }
+  return path;
+}
+
+/*********************************************************************
+** Function: ProceduralMazeText
+** Description: Generates the text of a maze data file of procedurally
+ * generated levels in memory.
+** Parameters: opts are the generator's options.
+** Pre-Conditions: None
+** Post-Conditions: Returns the text; throws if the options are invalid.
+*********************************************************************/
+std::string ProceduralMazeText(const ProceduralMazeOptions& opts) {
+  CheckOptions(opts);
+
+  std::string text = MazeHeader(opts);
+  const std::size_t row_size = static_cast<std::size_t>(opts.width) + 1;
+  std::size_t offset = text.size();
+  text.resize(offset + static_cast<std::size_t>(opts.levels) * opts.height *
+                       row_size);
+
+  for (unsigned i = 0; i != opts.levels; ++i) {
+    ProceduralLevel level(opts, i);
+    for (unsigned row = 0; row != opts.height; ++row, offset += row_size) {
+      level.NextRow(&text[offset]);
+    }
+  }
+  return text;
+}
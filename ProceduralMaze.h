@@ -0,0 +1,121 @@
+#ifndef ESCAPEFROMCS162_PROCEDURALMAZE_H
+#define ESCAPEFROMCS162_PROCEDURALMAZE_H
+/*********************************************************************
+** Program Filename: ProceduralMaze.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the ProceduralLevel class, which generates a level
+ * of a maze one row at a time, and functions that stream a whole maze of
+ * such levels to a maze data file or build its text in memory (e.g., for
+ * benchmarks).
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Parallel.h"
+#include "Rng.h"
+
+// Options for ProceduralLevel and WriteProceduralMaze.
+struct ProceduralMazeOptions {
+  unsigned levels = 1;
+  unsigned height = 41;
+  unsigned width = 81;
+  std::uint64_t seed = 0;
+  // Roughly the fraction of each level's area opened up into rooms.
+  double rooms = 0.1;
+  // The largest side of a room, in cells.
+  unsigned room_size = 9;
+  // The chance that a wall between two corridors that are already connected
+  // is opened anyway, adding a loop.
+  double loops = 0.05;
+  unsigned threads = DefaultThreadCount();
+};
+
+// Generates one level of a maze with Eller's algorithm, which builds a
+// perfect maze a row at a time while remembering only which cells of the
+// current row are connected, so a level of any height takes memory
+// proportional to its width. Corridor cells sit at odd rows and columns, with
+// walls (or passages) between them; rooms and loops only ever remove walls,
+// so every open cell, and in particular the ladder, stays reachable from the
+// beginning. Each level draws from its own stream of the options' seed, so it
+// comes out the same whichever thread generates it.
+class ProceduralLevel {
+  public:
+    ProceduralLevel(const ProceduralMazeOptions& opts, unsigned level);
+
+    // Writes the next row, followed by a newline, to out, which must have
+    // room for width + 1 characters.
+    void NextRow(char* out);
+
+  private:
+    // The open rectangle of a room, in rows and columns of the level.
+    struct Room {
+      unsigned top, bottom, left, right;
+    };
+
+    unsigned height_;
+    unsigned width_;
+    unsigned room_size_;
+    // The number of rows and columns of corridor cells.
+    unsigned cell_rows_;
+    unsigned cell_cols_;
+    // Thresholds for Chance.
+    std::uint64_t loop_chance_;
+    std::uint64_t room_chance_;
+    Rng rng_;
+    // Random bits not yet used by Coin.
+    std::uint64_t coins_ = 0;
+    unsigned coin_bits_ = 0;
+    unsigned row_ = 0;
+    // The corridor cells holding the beginning and the ladder (or instructor).
+    std::uint64_t start_;
+    std::uint64_t exit_;
+    char exit_glyph_;
+
+    // The set label of each corridor cell of the current row, and a
+    // union-find forest over the labels for joining them.
+    std::vector<unsigned> set_;
+    std::vector<unsigned> parent_;
+    std::vector<unsigned> root_;
+    // Whether each cell of the current row opens to the right and down.
+    std::vector<unsigned char> right_;
+    std::vector<unsigned char> down_;
+    // Per set, while choosing where it goes down.
+    std::vector<unsigned char> has_down_;
+    std::vector<unsigned> candidate_;
+    // The labels no set carried down to the next row is using.
+    std::vector<unsigned> free_labels_;
+    std::vector<Room> rooms_;
+
+    bool Coin();
+    bool Chance(std::uint64_t threshold);
+    unsigned Find(unsigned label);
+    void JoinRow(bool last);
+    void CarryDown();
+    void StartRooms(unsigned row);
+    void DrawRooms(char* out, unsigned row);
+};
+
+// Writes a maze data file of opts.levels procedurally generated levels. The
+// file is sized up front and the levels are generated on opts.threads
+// threads, each streaming its rows to the level's place in the file a chunk
+// at a time, so neither the file nor a level is ever held in memory. Throws
+// if the options are invalid or the file can't be written; returns the size
+// of the file.
+std::uint64_t WriteProceduralMaze(const std::string& path,
+    const ProceduralMazeOptions& opts);
+
+// Same as WriteProceduralMaze, but writes the maze to a new temporary file
+// and returns its path; the caller should remove the file when done.
+std::string WriteTemporaryProceduralMaze(const ProceduralMazeOptions& opts);
+
+// Returns the text of the maze data file WriteProceduralMaze would write.
+// Throws if the options are invalid.
+std::string ProceduralMazeText(const ProceduralMazeOptions& opts);
+
+
+#endif //ESCAPEFROMCS162_PROCEDURALMAZE_H
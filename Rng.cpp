@@ -0,0 +1,84 @@
+/*********************************************************************
+** Program Filename: Rng.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the Rng class and in the Rng
+ * header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <random>
+#include <stdexcept>
+#include "Rng.h"
+
+namespace {
+
+/*********************************************************************
+** Function: SplitMix64
+** Description: Advances the SplitMix64 state and returns its next output;
+ * used to expand a single seed into a full generator state.
+** Parameters: state is the SplitMix64 state.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::uint64_t SplitMix64(std::uint64_t& state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+}  // namespace
+
+/*********************************************************************
+** Function: Rng
+** Description: Constructor for the Rng class.
+** Parameters: seed is the seed; any value (including zero) is fine.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Rng::Rng(std::uint64_t seed) {
+  for (auto& word : s_) word = SplitMix64(seed);
+}
+
+/*********************************************************************
+** Function: ForStream
+** Description: Returns the generator for one stream of a master seed.
+** Parameters: seed is the master seed; stream identifies the stream.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Rng Rng::ForStream(std::uint64_t seed, std::uint64_t stream) {
+  std::uint64_t mixed = stream;
+  return Rng(seed ^ SplitMix64(mixed));
+}
+
+/*********************************************************************
+** Function: FromState
+** Description: Returns a generator with the given state.
+** Parameters: state is a state returned by state().
+** Pre-Conditions: None
+** Post-Conditions: Throws if the state is all zeroes, which xoshiro256**
+ * can never reach (and would never leave).
+*********************************************************************/
+Rng Rng::FromState(const State& state) {
+  if (state[0] == 0 && state[1] == 0 && state[2] == 0 && state[3] == 0)
+    throw std::invalid_argument("Random number generator state is all zero.");
+
+  Rng rng;
+  for (unsigned i = 0; i != 4; ++i) rng.s_[i] = state[i];
+  return rng;
+}
+
+/*********************************************************************
+** Function: RandomSeed
+** Description: Returns a nondeterministic master seed, for when none was
+ * given.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+std::uint64_t RandomSeed() {
+  std::random_device r;
+  return (static_cast<std::uint64_t>(r()) << 32) ^ r();
+}
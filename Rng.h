@@ -0,0 +1,97 @@
+#ifndef ESCAPEFROMCS162_RNG_H
+#define ESCAPEFROMCS162_RNG_H
+/*********************************************************************
+** Program Filename: Rng.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the Rng class, the random number generator used
+ * throughout the program, and its related members.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <array>
+#include <cstdint>
+
+// A small, fast xoshiro256** generator. Every random choice in a game comes
+// from an Rng derived from the maze's master seed, so the same seed always
+// replays the same game. Rng satisfies the standard's uniform random bit
+// generator requirements, so it also works with <algorithm> and <random>.
+class Rng {
+  public:
+    typedef std::uint64_t result_type;
+
+    explicit Rng(std::uint64_t seed = 0);
+
+    // Returns the generator for the given stream of the given master seed;
+    // different streams are statistically independent.
+    static Rng ForStream(std::uint64_t seed, std::uint64_t stream);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+    result_type operator()() { return Next(); }
+
+    std::uint64_t Next();
+    std::uint64_t Below(std::uint64_t bound);
+
+    // Returns a new generator seeded from this one (e.g., for a TA placed on
+    // this generator's level).
+    Rng Split() { return Rng(Next()); }
+
+    // The generator's complete state, for saving and restoring it; a restored
+    // generator continues exactly where the saved one left off.
+    typedef std::array<std::uint64_t, 4> State;
+    State state() const { return State{{s_[0], s_[1], s_[2], s_[3]}}; }
+    static Rng FromState(const State& state);
+
+  private:
+    std::uint64_t s_[4];
+};
+
+std::uint64_t RandomSeed();
+
+/*********************************************************************
+** Function: Next
+** Description: Returns the next 64 random bits.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+inline std::uint64_t Rng::Next() {
+  auto rotl = [](std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); };
+
+  const std::uint64_t result = rotl(s_[1] * 5, 7) * 9;
+  const std::uint64_t t = s_[1] << 17;
+  s_[2] ^= s_[0];
+  s_[3] ^= s_[1];
+  s_[1] ^= s_[2];
+  s_[0] ^= s_[3];
+  s_[2] ^= t;
+  s_[3] = rotl(s_[3], 45);
+  return result;
+}
+
+/*********************************************************************
+** Function: Below
+** Description: Returns a uniformly distributed integer in [0, bound), using
+ * a multiply and shift (with rare rejections) instead of a division.
+** Parameters: bound is the exclusive upper bound.
+** Pre-Conditions: bound > 0
+** Post-Conditions: None
+*********************************************************************/
+inline std::uint64_t Rng::Below(std::uint64_t bound) {
+  unsigned __int128 m = static_cast<unsigned __int128>(Next()) * bound;
+  auto low = static_cast<std::uint64_t>(m);
+  if (low < bound) {
+    const std::uint64_t threshold = -bound % bound;
+    while (low < threshold) {
+      m = static_cast<unsigned __int128>(Next()) * bound;
+      low = static_cast<std::uint64_t>(m);
+    }
+  }
+  return static_cast<std::uint64_t>(m >> 64);
+}
+
+
+#endif //ESCAPEFROMCS162_RNG_H
@@ -0,0 +1,324 @@
+/*********************************************************************
+** Program Filename: SimulateCS162.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Application file for the headless Escape from CS 162 runner,
+ * which plays many games per maze with a student policy and reports
+ * throughput, or which replays a game recorded with EscapeFromCS162 --record
+ * as fast as it can, checking that every turn has the result it was recorded
+ * with, or which estimates the probability that a policy wins within
+ * --max-turns turns from the start of a game (or from a checkpoint) by
+ * playing --games randomized rollouts on --threads threads.
+ * Usage: SimulateCS162 [--games N] [--max-turns N] [--policy NAME]
+ *                      [--tas wander|chase] [--load-threads N] [--seed N]
+ *                      MAZE...
+ *        SimulateCS162 --replay LOG [--games N] MAZE...
+ *        SimulateCS162 --estimate [--checkpoint FILE] [--threads N]
+ *                      [--games N] [--max-turns N] [--policy NAME]
+ *                      [--tas wander|chase] [--seed N] MAZE...
+** Input: Paths to maze data files.
+** Output: Per-maze game statistics.
+*********************************************************************/
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include "ActionLog.h"
+#include "Maze.h"
+#include "Parallel.h"
+#include "Simulation.h"
+#include "StudentPolicy.h"
+#include "WinEstimator.h"
+
+// Options parsed from the command line.
+struct SimulationOptions {
+  unsigned long games = 1000;
+  unsigned long max_turns = 10000;
+  std::string policy = "random";
+  TaBehavior ta_behavior = TaBehavior::Wander;
+  unsigned load_threads = DefaultThreadCount();
+  std::uint64_t seed = RandomSeed();
+  // Replays this action log instead of simulating, --games times (once if
+  // --games isn't given).
+  std::string replay_path;
+  // Estimates the policy's chance of winning instead of simulating, starting
+  // from checkpoint_path if it is given.
+  bool estimate = false;
+  std::string checkpoint_path;
+  unsigned threads = DefaultThreadCount();
+  std::vector<std::string> maze_paths;
+};
+
+/*********************************************************************
+** Function: ParseOptions
+** Description: Parses the command line arguments.
+** Parameters: argc and argv are the arguments given to main.
+** Pre-Conditions: None
+** Post-Conditions: Returns None if the arguments are invalid.
+*********************************************************************/
+Option<SimulationOptions> ParseOptions(int argc, char** argv) {
+  SimulationOptions opts;
+  bool games_given = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+
+    if (arg == "--games" || arg == "--max-turns" || arg == "--policy" ||
+        arg == "--load-threads" || arg == "--seed" || arg == "--replay" ||
+        arg == "--tas" || arg == "--checkpoint" || arg == "--threads") {
+      if (i + 1 >= argc) return None;
+      std::istringstream iss(argv[++i]);
+
+      if (arg == "--games") iss >> opts.games, games_given = true;
+      else if (arg == "--max-turns") iss >> opts.max_turns;
+      else if (arg == "--load-threads") iss >> opts.load_threads;
+      else if (arg == "--seed") iss >> opts.seed;
+      else if (arg == "--replay") iss >> opts.replay_path;
+      else if (arg == "--checkpoint") iss >> opts.checkpoint_path;
+      else if (arg == "--threads") iss >> opts.threads;
+      else if (arg == "--tas") {
+        Option<TaBehavior> behavior = TaBehaviorNamed(iss.str());
+        if (behavior.IsNone()) return None;
+        opts.ta_behavior = behavior.Unwrap();
+      }
+      else iss >> opts.policy;
+
+      if (!iss) return None;
+    } else if (arg == "--estimate") {
+      opts.estimate = true;
+    } else {
+      opts.maze_paths.push_back(arg);
+    }
+  }
+
+  if (opts.maze_paths.empty()) return None;
+  if (!opts.replay_path.empty() && !games_given) opts.games = 1;
+  return opts;
+}
+
+/*********************************************************************
+** Function: SimulateMaze
+** Description: Plays the requested number of games on one maze and prints
+ * the results.
+** Parameters: path is the path to the maze data file; opts are the
+ * simulation options; policy chooses the student's actions.
+** Pre-Conditions: None
+** Post-Conditions: Returns false if the maze could not be opened.
+*********************************************************************/
+bool SimulateMaze(const std::string& path, const SimulationOptions& opts,
+    StudentPolicy& policy) {
+  if (!std::ifstream(path)) {
+    std::cerr << "Unable to open stream to maze data file " << path << ".\n";
+    return false;
+  }
+
+  auto load_start = std::chrono::steady_clock::now();
+  Maze maze(path, opts.load_threads, opts.seed);
+  std::chrono::duration<double> load_elapsed =
+      std::chrono::steady_clock::now() - load_start;
+  maze.set_student_policy(&policy);
+  maze.set_ta_behavior(opts.ta_behavior);
+
+  GameOutcome totals;
+  unsigned long wins = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned long g = 0; g != opts.games; ++g) {
+    GameOutcome outcome = PlayHeadlessGame(maze, opts.max_turns);
+    if (outcome.satisfied_instructor) ++wins;
+    totals.turns += outcome.turns;
+    totals.skills_acquired += outcome.skills_acquired;
+    totals.caught_by_ta += outcome.caught_by_ta;
+    totals.failed_by_instructor += outcome.failed_by_instructor;
+
+    // Every game starts from a fresh maze.
+    maze.ResetAllLevels();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  double secs = elapsed.count() > 0 ? elapsed.count() : 1e-9;
+  std::cout << path << ":\n"
+            << "  Seed: " << maze.seed() << '\n'
+            << "  Load: " << load_elapsed.count() << " s\n"
+            << "  Games: " << opts.games << " (" << wins << " won)\n"
+            << "  Turns: " << totals.turns << '\n'
+            << "  Skills acquired: " << totals.skills_acquired << '\n'
+            << "  Caught by TAs: " << totals.caught_by_ta << '\n'
+            << "  Failed by instructor: " << totals.failed_by_instructor << '\n'
+            << "  Elapsed: " << elapsed.count() << " s\n"
+            << "  Games/sec: " << (opts.games / secs) << '\n'
+            << "  Turns/sec: " << (totals.turns / secs) << '\n';
+  return true;
+}
+
+/*********************************************************************
+** Function: ReplayMaze
+** Description: Replays an action log on one maze the requested number of
+ * times and prints the results.
+** Parameters: path is the path to the maze data file the log was recorded
+ * on; opts are the simulation options; log is the action log.
+** Pre-Conditions: None
+** Post-Conditions: Returns false if the maze could not be opened; throws if
+ * the replay diverges from the log.
+*********************************************************************/
+bool ReplayMaze(const std::string& path, const SimulationOptions& opts,
+    const ActionLog& log) {
+  if (!std::ifstream(path)) {
+    std::cerr << "Unable to open stream to maze data file " << path << ".\n";
+    return false;
+  }
+
+  Maze maze(path, opts.load_threads, opts.seed);
+  unsigned long turns = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned long g = 0; g != opts.games; ++g) {
+    turns += ReplayActionLog(maze, log);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  double secs = elapsed.count() > 0 ? elapsed.count() : 1e-9;
+  std::cout << path << ":\n"
+            << "  Replayed: " << opts.replay_path << " (" << log.turns()
+            << " turns, matched)\n"
+            << "  Replays: " << opts.games << '\n'
+            << "  Turns: " << turns << '\n'
+            << "  Elapsed: " << elapsed.count() << " s\n"
+            << "  Turns/sec: " << (turns / secs) << '\n';
+  return true;
+}
+
+/*********************************************************************
+** Function: ReplayMain
+** Description: Reads the action log named by the options and replays it on
+ * every maze.
+** Parameters: opts are the simulation options.
+** Pre-Conditions: opts.replay_path is not empty.
+** Post-Conditions: Returns the program's exit status.
+*********************************************************************/
+int ReplayMain(const SimulationOptions& opts) {
+  std::ifstream is(opts.replay_path, std::ios::binary);
+  if (!is) {
+    std::cerr << "Unable to open action log " << opts.replay_path << ".\n";
+    return -1;
+  }
+
+  Option<ActionLog> log = None;
+  try {
+    log = ActionLog(is);
+  } catch (const std::exception& e) {
+    std::cerr << opts.replay_path << ": " << e.what() << '\n';
+    return -1;
+  }
+
+  int status = 0;
+  for (const auto& path : opts.maze_paths) {
+    try {
+      if (!ReplayMaze(path, opts, log.CUnwrapRef())) status = -1;
+    } catch (const std::exception& e) {
+      std::cerr << path << ": " << e.what() << '\n';
+      status = -1;
+    }
+  }
+
+  return status;
+}
+
+/*********************************************************************
+** Function: EstimateMaze
+** Description: Estimates the policy's chance of winning on one maze and
+ * prints the estimate.
+** Parameters: path is the path to the maze data file; opts are the
+ * simulation options.
+** Pre-Conditions: None
+** Post-Conditions: Returns false if the maze or checkpoint could not be
+ * opened.
+*********************************************************************/
+bool EstimateMaze(const std::string& path, const SimulationOptions& opts) {
+  if (!std::ifstream(path)) {
+    std::cerr << "Unable to open stream to maze data file " << path << ".\n";
+    return false;
+  }
+
+  Maze maze(path, opts.load_threads, opts.seed);
+  maze.set_ta_behavior(opts.ta_behavior);
+
+  if (!opts.checkpoint_path.empty()) {
+    std::ifstream is(opts.checkpoint_path, std::ios::binary);
+    if (!is) {
+      std::cerr << "Unable to open checkpoint " << opts.checkpoint_path
+                << ".\n";
+      return false;
+    }
+    maze.LoadCheckpoint(is);
+  }
+
+  WinEstimateOptions estimate_opts;
+  estimate_opts.rollouts = opts.games;
+  estimate_opts.max_turns = opts.max_turns;
+  estimate_opts.policy = opts.policy;
+  estimate_opts.seed = opts.seed;
+  estimate_opts.threads = opts.threads;
+
+  auto start = std::chrono::steady_clock::now();
+  WinEstimate estimate = EstimateWinProbability(maze, estimate_opts);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  double secs = elapsed.count() > 0 ? elapsed.count() : 1e-9;
+  std::cout << path << ":\n"
+            << "  Seed: " << opts.seed << '\n'
+            << "  Rollouts: " << estimate.rollouts << " (" << estimate.wins
+            << " won within " << opts.max_turns << " turns)\n"
+            << "  Win probability: " << estimate.probability << " (95% CI "
+            << estimate.lower << " to " << estimate.upper << ")\n"
+            << "  Turns: " << estimate.turns << '\n'
+            << "  Threads: " << opts.threads << '\n'
+            << "  Elapsed: " << elapsed.count() << " s\n"
+            << "  Rollouts/sec: " << (estimate.rollouts / secs) << '\n'
+            << "  Turns/sec: " << (estimate.turns / secs) << '\n';
+  return true;
+}
+
+int main(int argc, char** argv) {
+  Option<SimulationOptions> parsed = ParseOptions(argc, argv);
+  if (parsed.IsNone()) {
+    std::cerr << "Usage: " << argv[0] << " [--games N] [--max-turns N] "
+              << "[--policy random|autopilot] [--tas wander|chase] "
+              << "[--load-threads N] [--seed N] MAZE...\n"
+              << "       " << argv[0] << " --replay LOG [--games N] MAZE...\n"
+              << "       " << argv[0] << " --estimate [--checkpoint FILE] "
+              << "[--threads N] [--games N] [--max-turns N] [--policy NAME] "
+              << "[--tas wander|chase] [--seed N] MAZE...\n";
+    return -1;
+  }
+
+  SimulationOptions opts = parsed.Unwrap();
+  if (!opts.replay_path.empty()) return ReplayMain(opts);
+
+  Option<StudentPolicy*> policy = MakeStudentPolicy(opts.policy, opts.seed);
+  if (policy.IsNone()) {
+    std::cerr << "Unknown student policy: " << opts.policy << ".\n";
+    return -1;
+  }
+
+  StudentPolicy* student_policy = policy.Unwrap();
+  int status = 0;
+
+  for (const auto& path : opts.maze_paths) {
+    try {
+      if (opts.estimate) {
+        if (!EstimateMaze(path, opts)) status = -1;
+      } else if (!SimulateMaze(path, opts, *student_policy)) {
+        status = -1;
+      }
+    } catch (const std::exception& e) {
+      std::cerr << path << ": " << e.what() << '\n';
+      status = -1;
+    }
+  }
+
+  delete student_policy;
+  return status;
+}
@@ -0,0 +1,75 @@
+/*********************************************************************
+** Program Filename: Simulation.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared in the Simulation header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include "Simulation.h"
+#include "Instrumentation.h"
+
+/*********************************************************************
+** Function: PlayTurn
+** Description: Plays a single turn of the game, applying the same resets as
+ * the interactive game loop when the student is caught or failed.
+** Parameters: maze is the game's maze.
+** Pre-Conditions: The maze has a student policy set.
+** Post-Conditions: None
+*********************************************************************/
+MoveResult PlayTurn(Maze& maze) {
+  ESC162_INSTRUMENT_POLL();
+  ESC162_TIME_PHASE(kPhaseTurn);
+
+  maze.MovePeople();
+  MoveResult result = maze.HandleCurrentPosition();
+
+  switch (result) {
+    case MoveResult::CaughtByTA:
+      maze.ResetCurrentLevel();
+      break;
+    case MoveResult::FailedByInstructor:
+      maze.ResetAllLevels();
+      break;
+    default:
+      break;
+  }
+
+  return result;
+}
+
+/*********************************************************************
+** Function: PlayHeadlessGame
+** Description: Plays turns until the student satisfies the instructor or
+ * max_turns turns have been played.
+** Parameters: maze is the game's maze; max_turns is the maximum number of
+ * turns to play.
+** Pre-Conditions: The maze has a student policy set.
+** Post-Conditions: None
+*********************************************************************/
+GameOutcome PlayHeadlessGame(Maze& maze, unsigned long max_turns) {
+  GameOutcome outcome;
+
+  while (outcome.turns < max_turns) {
+    ++outcome.turns;
+
+    switch (PlayTurn(maze)) {
+      case MoveResult::AcquiredSkill:
+        ++outcome.skills_acquired;
+        break;
+      case MoveResult::CaughtByTA:
+        ++outcome.caught_by_ta;
+        break;
+      case MoveResult::FailedByInstructor:
+        ++outcome.failed_by_instructor;
+        break;
+      case MoveResult::SatisfiedInstructor:
+        outcome.satisfied_instructor = true;
+        return outcome;
+      case MoveResult::NoEvent:
+        break;
+    }
+  }
+
+  return outcome;
+}
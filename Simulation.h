@@ -0,0 +1,29 @@
+#ifndef ESCAPEFROMCS162_SIMULATION_H
+#define ESCAPEFROMCS162_SIMULATION_H
+/*********************************************************************
+** Program Filename: Simulation.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares functions for playing games headlessly (without
+ * prompting or printing anything).
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include "Maze.h"
+
+// Summary of a single headless game.
+struct GameOutcome {
+  bool satisfied_instructor = false;
+  unsigned long turns = 0;
+  unsigned long skills_acquired = 0;
+  unsigned long caught_by_ta = 0;
+  unsigned long failed_by_instructor = 0;
+};
+
+MoveResult PlayTurn(Maze& maze);
+GameOutcome PlayHeadlessGame(Maze& maze, unsigned long max_turns);
+
+
+#endif //ESCAPEFROMCS162_SIMULATION_H
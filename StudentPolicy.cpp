@@ -0,0 +1,82 @@
+/*********************************************************************
+** Program Filename: StudentPolicy.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the StudentPolicy classes
+ * and in the StudentPolicy header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <algorithm>
+#include "StudentPolicy.h"
+#include "Maze.h"
+
+/*********************************************************************
+** Function: ChooseAction
+** Description: Randomly selects an action from the given list of valid
+ * actions.
+** Parameters: maze is the maze being played; valid_actions is a vector of all
+ * valid actions the student can make.
+** Pre-Conditions: valid_actions is not empty.
+** Post-Conditions: None
+*********************************************************************/
+PlayerAction RandomStudentPolicy::ChooseAction(Maze&,
+    const std::vector<PlayerAction>& valid_actions) {
+  return valid_actions[rng_.Below(valid_actions.size())];
+}
+
+/*********************************************************************
+** Function: ChooseAction
+** Description: Takes the next step toward the student's current goal: the
+ * nearest skill while they have too few to satisfy the instructor, otherwise
+ * the ladder (climbing it once there) or the instructor.
+** Parameters: maze is the maze being played; valid_actions is a vector of all
+ * valid actions the student can make.
+** Pre-Conditions: valid_actions is not empty.
+** Post-Conditions: None
+*********************************************************************/
+PlayerAction AutopilotStudentPolicy::ChooseAction(Maze& maze,
+    const std::vector<PlayerAction>& valid_actions) {
+  auto is_valid = [&](PlayerAction action) {
+      return std::find(valid_actions.begin(), valid_actions.end(), action)
+          != valid_actions.end();
+  };
+
+  MazeLevel& level = maze.CurrentStudentLevel();
+  unsigned index = level.IndexOf(maze.student()->position());
+
+  std::vector<DistanceTarget> goals;
+  if (maze.student()->prog_skills() < 3) goals.push_back(DistanceTarget::Skill);
+  goals.push_back(DistanceTarget::Ladder);
+  goals.push_back(DistanceTarget::Instructor);
+
+  for (DistanceTarget goal : goals) {
+    if (goal == DistanceTarget::Ladder && is_valid(PlayerAction::ClimbUp))
+      return PlayerAction::ClimbUp;
+
+    Option<PlayerDirectionAction> step =
+        level.DistanceFieldTo(goal).NextStep(level, index);
+    if (step.IsSome()) return PlayerDirectionToAction(step.Unwrap());
+  }
+
+  return valid_actions[rng_.Below(valid_actions.size())];
+}
+
+/*********************************************************************
+** Function: MakeStudentPolicy
+** Description: Creates the policy with the given name; the caller owns the
+ * returned policy.
+** Parameters: name is the name of the policy ("random" or "autopilot"); seed
+ * is the master seed the policy draws its random choices from.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+Option<StudentPolicy*> MakeStudentPolicy(const std::string& name,
+    std::uint64_t seed) {
+  Rng rng = Rng::ForStream(seed, kStudentPolicyStream);
+  if (name == "random")
+    return Option<StudentPolicy*>(new RandomStudentPolicy(rng));
+  if (name == "autopilot")
+    return Option<StudentPolicy*>(new AutopilotStudentPolicy(rng));
+  return None;
+}
@@ -0,0 +1,68 @@
+#ifndef ESCAPEFROMCS162_STUDENTPOLICY_H
+#define ESCAPEFROMCS162_STUDENTPOLICY_H
+/*********************************************************************
+** Program Filename: StudentPolicy.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the StudentPolicy interface and the built-in
+ * policies used to drive the student without a terminal.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <string>
+#include <vector>
+#include "PlayerAction.h"
+#include "Rng.h"
+
+class Maze;
+
+// A StudentPolicy picks the student's action each turn in place of prompting
+// the player. The maze only ever passes actions that are valid at the
+// student's current position, and valid_actions is never empty.
+class StudentPolicy {
+  public:
+    // Just in case.
+    virtual ~StudentPolicy() = default;
+
+    virtual PlayerAction ChooseAction(Maze& maze,
+        const std::vector<PlayerAction>& valid_actions) = 0;
+};
+
+// Picks uniformly at random from the valid actions.
+class RandomStudentPolicy : public StudentPolicy {
+  public:
+    explicit RandomStudentPolicy(Rng rng): rng_(rng) {}
+
+    PlayerAction ChooseAction(Maze& maze,
+        const std::vector<PlayerAction>& valid_actions) override;
+
+  private:
+    Rng rng_;
+};
+
+// Walks the shortest path to the nearest skill until the student has enough
+// to satisfy the instructor, then up the ladders and to the instructor, using
+// the distance fields cached by each MazeLevel. It ignores TAs, and falls
+// back to a random action when no path helps.
+class AutopilotStudentPolicy : public StudentPolicy {
+  public:
+    explicit AutopilotStudentPolicy(Rng rng): rng_(rng) {}
+
+    PlayerAction ChooseAction(Maze& maze,
+        const std::vector<PlayerAction>& valid_actions) override;
+
+  private:
+    Rng rng_;
+};
+
+// The stream of the master seed (see Rng::ForStream) that student policies
+// draw from; level streams are numbered from zero, so this never collides.
+const std::uint64_t kStudentPolicyStream = UINT64_MAX;
+
+Option<StudentPolicy*> MakeStudentPolicy(const std::string& name,
+    std::uint64_t seed);
+
+
+#endif //ESCAPEFROMCS162_STUDENTPOLICY_H
@@ -17,17 +17,57 @@
 ** Post-Conditions: None
 *********************************************************************/
 Option<PlayerAction> TA::GetMove(std::vector<PlayerAction> valid_moves) {
+  unsigned move_mask = 0;
+  for (const auto& m : valid_moves) {
+    Option<PlayerDirectionAction> dir = PlayerActionToDirection(m);
+    if (dir.IsSome())
+      move_mask |= DirectionBit(dir.Unwrap());
+  }
+
+  return GetMoveFromMask(move_mask);
+}
+
+/*********************************************************************
+** Function: GetMoveFromMask
+** Description: Randomly selects a move from the directions set in the given
+ * move mask (see MazeLevel::MoveMaskAt).
+** Parameters: move_mask has a DirectionBit set for every valid direction.
+** Pre-Conditions: None
+** Post-Conditions: Returns None if the mask has no directions set.
+*********************************************************************/
+Option<PlayerAction> TA::GetMoveFromMask(unsigned move_mask) {
   // Calling GetMove is considered a single turn, so it has the side effect of
   // decreasing the number of turns the TA is appeased.
   DecrementAppeasement();
 
-  std::vector<PlayerDirectionAction> valid_dirs;
-  for (const auto& m : valid_moves) {
-    Option<PlayerDirectionAction> dir = PlayerActionToDirection(m);
-    if (dir.IsSome())
-      valid_dirs.push_back(dir.Unwrap());
+  unsigned count = __builtin_popcount(move_mask);
+  if (count == 0) return None;
+
+  // Pick the n-th set bit of the mask.
+  for (auto n = rng_.Below(count); n != 0; --n) {
+    move_mask &= move_mask - 1;
   }
 
-  std::uniform_int_distribution<unsigned long> uni(0, valid_dirs.size() - 1);
-  return PlayerDirectionToAction(valid_dirs[uni(rng_engine_)]);
+  auto dir = static_cast<PlayerDirectionAction>(__builtin_ctz(move_mask));
+  return PlayerDirectionToAction(dir);
+}
+
+/*********************************************************************
+** Function: GetChaseMove
+** Description: Takes the given step toward the student unless the TA is
+ * appeased or there is no step to take, in which case the TA moves randomly
+ * as in GetMoveFromMask.
+** Parameters: move_mask has a DirectionBit set for every valid direction;
+ * step is the direction toward the student from the TA's cell (see
+ * FlowField::StepFrom).
+** Pre-Conditions: step, if any, is set in move_mask.
+** Post-Conditions: Returns None if the mask has no directions set.
+*********************************************************************/
+Option<PlayerAction> TA::GetChaseMove(unsigned move_mask,
+    Option<PlayerDirectionAction> step) {
+  if (IsAppeased() || step.IsNone()) return GetMoveFromMask(move_mask);
+
+  // Still a turn, even though no random choice is made.
+  DecrementAppeasement();
+  return PlayerDirectionToAction(step.Unwrap());
 }
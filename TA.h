@@ -11,25 +11,32 @@
 
 
 #include "MazePerson.h"
+#include "Rng.h"
 
 class TA : public MazePerson {
   public:
-    explicit TA(MazePosition pos): MazePerson(pos) {}
+    TA(MazePosition pos, Rng rng): MazePerson(pos), rng_(rng) {}
 
     Option<PlayerAction>
     GetMove(std::vector<PlayerAction> valid_moves) override;
+    Option<PlayerAction> GetMoveFromMask(unsigned move_mask);
+    Option<PlayerAction> GetChaseMove(unsigned move_mask,
+        Option<PlayerDirectionAction> step);
 
-    void Occupy(OpenSpace* space) override { space->set_has_ta(true); }
-    void Unoccupy(OpenSpace* space) override { space->set_has_ta(false); }
+    void Occupy(OpenSpace space) override { space.set_has_ta(true); }
+    void Unoccupy(OpenSpace space) override { space.set_has_ta(false); }
 
     void Appease() { appeased_turns_ += 10; }
     bool IsAppeased() { return appeased_turns_ > 0; }
     void DecrementAppeasement() { if (appeased_turns_ > 0) --appeased_turns_; }
 
     unsigned appeased_turns() const { return appeased_turns_; }
+    void set_appeased_turns(unsigned turns) { appeased_turns_ = turns; }
+    const Rng& rng() const { return rng_; }
+    void set_rng(Rng rng) { rng_ = rng; }
 
   private:
-    std::mt19937 rng_engine_ = MakeRngEngine();
+    Rng rng_;
 
     unsigned appeased_turns_ = 0;
 };
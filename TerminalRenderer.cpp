@@ -0,0 +1,250 @@
+/*********************************************************************
+** Program Filename: TerminalRenderer.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared by the TerminalRenderer class
+ * and in the TerminalRenderer header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include "Instrumentation.h"
+#include "TerminalRenderer.h"
+
+const unsigned TerminalRenderer::kPromptRows;
+
+namespace {
+
+/*********************************************************************
+** Function: ViewportOrigin
+** Description: Returns where a viewport should start along one axis so that
+ * it shows a position, keeping the viewport still unless the position has
+ * come within a quarter of the viewport of its edge.
+** Parameters: pos is the position to show; origin is where the viewport
+ * starts now; view is the viewport's length; size is the level's length;
+ * recenter is whether to center the viewport on pos regardless.
+** Pre-Conditions: pos < size
+** Post-Conditions: None
+*********************************************************************/
+unsigned ViewportOrigin(unsigned pos, unsigned origin, unsigned view,
+    unsigned size, bool recenter) {
+  if (view >= size) return 0;
+
+  unsigned margin = view / 4;
+  if (!recenter && pos >= origin + margin && pos < origin + view - margin)
+    return origin;
+
+  unsigned centered = pos < view / 2 ? 0 : pos - view / 2;
+  return std::min(centered, size - view);
+}
+
+}  // namespace
+
+/*********************************************************************
+** Function: IsAnsiTerminal
+** Description: Returns whether standard output is a terminal that
+ * understands ANSI escape sequences.
+** Parameters: None
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+bool IsAnsiTerminal() {
+  const char* term = std::getenv("TERM");
+  return isatty(STDOUT_FILENO) && term != nullptr && *term != '\0'
+      && std::strcmp(term, "dumb") != 0;
+}
+
+/*********************************************************************
+** Function: Render
+** Description: Draws the maze's current state, redrawing the whole screen
+ * only when the previous frame can't be patched.
+** Parameters: maze is the maze to draw; os is the terminal's stream.
+** Pre-Conditions: os is an ANSI terminal.
+** Post-Conditions: The student's level no longer has any changed cells
+ * logged.
+*********************************************************************/
+void TerminalRenderer::Render(Maze& maze, std::ostream& os) {
+  ESC162_TIME_PHASE(kPhaseRender);
+  MazeLevel& level = maze.CurrentStudentLevel();
+
+  status_.Clear();
+  maze.PrintStatus(status_.stream());
+  unsigned status_rows = static_cast<unsigned>(
+      std::count(status_.data(), status_.data() + status_.size(), '\n'));
+
+  bool moved = PlaceViewport(level, maze.student()->position(), status_rows);
+  bool full = !has_frame_ || moved || level.all_changed()
+      || status_rows != status_rows_
+      || frame_.size() != static_cast<std::size_t>(view_rows_) * view_cols_;
+
+  frame_buffer_.Clear();
+  if (full) {
+    frame_buffer_.Reserve(status_.size() + 2 * status_rows +
+                          static_cast<std::size_t>(view_rows_) *
+                          (view_cols_ + 1) + 32);
+    AppendEscape("\x1b[H\x1b[2J");
+  } else {
+    AppendEscape("\x1b[H");
+  }
+
+  AppendStatus();
+  status_rows_ = status_rows;
+
+  if (full) AppendLevel(level);
+  else AppendChangedCells(level);
+
+  // Leave the cursor on the line after the level, with anything printed
+  // there by the last turn cleared away.
+  AppendCursorTo(status_rows_ + view_rows_ + 1, 1);
+  AppendEscape("\x1b[J");
+
+  level.ClearChangedCells();
+  has_frame_ = true;
+  level_ = level.number();
+
+  frame_buffer_.WriteTo(os);
+  os.flush();
+}
+
+/*********************************************************************
+** Function: PlaceViewport
+** Description: Sizes the viewport to what fits in the terminal under the
+ * status and above the prompt, and moves it to keep the student in view.
+** Parameters: level is the level to draw; student is the student's
+ * position on it; status_rows is how many lines the status takes.
+** Pre-Conditions: None
+** Post-Conditions: Returns whether the terminal's size, the level, or the
+ * viewport changed since the last frame, so everything must be redrawn.
+*********************************************************************/
+bool TerminalRenderer::PlaceViewport(const MazeLevel& level,
+    MazePosition student, unsigned status_rows) {
+  // A terminal that won't report its size is treated as unbounded.
+  unsigned rows = 0;
+  unsigned cols = 0;
+  winsize ws;
+  if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0) {
+    rows = ws.ws_row;
+    cols = ws.ws_col;
+  }
+
+  unsigned view_rows = level.height();
+  if (rows != 0) {
+    unsigned fit = rows > status_rows + kPromptRows
+                   ? rows - status_rows - kPromptRows : 1;
+    view_rows = std::min(view_rows, fit);
+  }
+  unsigned view_cols = cols != 0 ? std::min(level.width(), cols)
+                                 : level.width();
+
+  bool changed = !has_frame_ || level.number() != level_ ||
+                 rows != term_rows_ || cols != term_cols_ ||
+                 view_rows != view_rows_ || view_cols != view_cols_;
+  unsigned top = ViewportOrigin(student.row, top_, view_rows, level.height(),
+                                changed);
+  unsigned left = ViewportOrigin(student.col, left_, view_cols, level.width(),
+                                 changed);
+  changed = changed || top != top_ || left != left_;
+
+  term_rows_ = rows;
+  term_cols_ = cols;
+  top_ = top;
+  left_ = left;
+  view_rows_ = view_rows;
+  view_cols_ = view_cols;
+  return changed;
+}
+
+/*********************************************************************
+** Function: AppendCursorTo
+** Description: Appends the escape sequence that moves the cursor.
+** Parameters: row and col are the (one-indexed) screen row and column.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void TerminalRenderer::AppendCursorTo(unsigned row, unsigned col) {
+  char seq[32];
+  int n = std::snprintf(seq, sizeof(seq), "\x1b[%u;%uH", row, col);
+  frame_buffer_.Append(seq, n);
+}
+
+/*********************************************************************
+** Function: AppendEscape
+** Description: Appends an escape sequence (or any other literal text).
+** Parameters: seq is the null-terminated sequence.
+** Pre-Conditions: None
+** Post-Conditions: None
+*********************************************************************/
+void TerminalRenderer::AppendEscape(const char* seq) {
+  frame_buffer_.Append(seq, std::strlen(seq));
+}
+
+/*********************************************************************
+** Function: AppendStatus
+** Description: Appends the status lines, clearing whatever was left on each
+ * line by the previous frame.
+** Parameters: None
+** Pre-Conditions: status_ holds the text printed by Maze::PrintStatus, and
+ * the cursor is at the top left of the screen.
+** Post-Conditions: None
+*********************************************************************/
+void TerminalRenderer::AppendStatus() {
+  const char* begin = status_.data();
+  const char* end = begin + status_.size();
+  for (const char* eol; (eol = std::find(begin, end, '\n')) != end;
+       begin = eol + 1) {
+    frame_buffer_.Append(begin, eol - begin);
+    AppendEscape("\x1b[K\n");
+  }
+}
+
+/*********************************************************************
+** Function: AppendLevel
+** Description: Appends the viewport's rows of the level and remembers what
+ * was drawn.
+** Parameters: level is the level to draw.
+** Pre-Conditions: The cursor is at the start of the line after the status.
+** Post-Conditions: None
+*********************************************************************/
+void TerminalRenderer::AppendLevel(const MazeLevel& level) {
+  std::size_t begin = frame_buffer_.size();
+  frame_buffer_.AppendLevelWindow(level, top_, left_, view_rows_, view_cols_);
+
+  // The frame holds each row followed by a newline; keep just the glyphs.
+  const unsigned width = view_cols_;
+  frame_.resize(static_cast<std::size_t>(view_rows_) * width);
+  const char* row = frame_buffer_.data() + begin;
+  for (unsigned i = 0; i != view_rows_; ++i, row += width + 1) {
+    std::copy(row, row + width, &frame_[static_cast<std::size_t>(i) * width]);
+  }
+}
+
+/*********************************************************************
+** Function: AppendChangedCells
+** Description: Appends a cursor move and the new glyph for every logged cell
+ * in the viewport whose glyph differs from the one on screen.
+** Parameters: level is the level on screen.
+** Pre-Conditions: The previous frame drew this level, and it has not been
+ * reset since.
+** Post-Conditions: None
+*********************************************************************/
+void TerminalRenderer::AppendChangedCells(const MazeLevel& level) {
+  for (unsigned index : level.changed_cells()) {
+    // Cells above or left of the viewport wrap around to large offsets.
+    unsigned row = index / level.width() - top_;
+    unsigned col = index % level.width() - left_;
+    if (row >= view_rows_ || col >= view_cols_) continue;
+
+    char& shown = frame_[static_cast<std::size_t>(row) * view_cols_ + col];
+    char glyph = CellDisplayCharacter(level.cell(index));
+    if (shown == glyph) continue;
+
+    shown = glyph;
+    AppendCursorTo(status_rows_ + 1 + row, 1 + col);
+    frame_buffer_.Append(glyph);
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef ESCAPEFROMCS162_TERMINALRENDERER_H
+#define ESCAPEFROMCS162_TERMINALRENDERER_H
+/*********************************************************************
+** Program Filename: TerminalRenderer.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares the TerminalRenderer class, which draws the game on
+ * an ANSI terminal by redrawing only the cells that changed.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <iostream>
+#include <vector>
+#include "FrameBuilder.h"
+#include "Maze.h"
+
+bool IsAnsiTerminal();
+
+// Draws the maze's state in place on an ANSI terminal. The first frame, and
+// any frame after a level change or reset, clears the screen and draws
+// everything; other frames rewrite the status lines and move the cursor to
+// each cell changed since the last frame (as logged by MazeLevel), so a turn
+// costs output proportional to what moved rather than to the level's size.
+// Every frame goes out in one write, leaving the cursor below the level.
+//
+// Cells are addressed by screen row, so the frame must never scroll. When the
+// status, the level, and kPromptRows more lines don't fit in the terminal
+// (as reported by TIOCGWINSZ), only a viewport of the level around the
+// student is drawn, and it moves (with a full redraw) whenever the student
+// gets near its edge.
+class TerminalRenderer {
+  public:
+    void Render(Maze& maze, std::ostream& os);
+    // Makes the next frame redraw everything, e.g. after other output has
+    // scrolled the screen.
+    void Invalidate() { has_frame_ = false; }
+
+  private:
+    bool has_frame_ = false;
+    unsigned level_ = 0;
+    unsigned status_rows_ = 0;
+    // The terminal's size when the last frame was drawn (0 if unknown).
+    unsigned term_rows_ = 0;
+    unsigned term_cols_ = 0;
+    // The part of level_ on screen: rows [top_, top_ + view_rows_) and
+    // columns [left_, left_ + view_cols_).
+    unsigned top_ = 0;
+    unsigned left_ = 0;
+    unsigned view_rows_ = 0;
+    unsigned view_cols_ = 0;
+    // The glyph currently shown for each cell of the viewport, row-major.
+    std::vector<char> frame_;
+    // Reused between frames, so a turn doesn't allocate once they have grown.
+    FrameBuilder frame_buffer_;
+    FrameBuilder status_;
+
+    // Lines kept free under the level for the action prompt and the messages
+    // printed between frames.
+    static const unsigned kPromptRows = 16;
+
+    bool PlaceViewport(const MazeLevel& level, MazePosition student,
+        unsigned status_rows);
+    void AppendEscape(const char* seq);
+    void AppendCursorTo(unsigned row, unsigned col);
+    void AppendStatus();
+    void AppendLevel(const MazeLevel& level);
+    void AppendChangedCells(const MazeLevel& level);
+};
+
+
+#endif //ESCAPEFROMCS162_TERMINALRENDERER_H
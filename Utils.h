@@ -13,7 +13,6 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
-#include <random>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -24,8 +23,6 @@
 template <class T>
 using InputValidationFn = std::function<bool(const T&)>;
 
-std::mt19937 MakeRngEngine();
-
 // Avoids need for explicit hash specialization when using enum class
 // types in an unordered_map, per https://stackoverflow.com/questions
 // /18837857/cant-use-enum-class-as-unordered-map-key
@@ -0,0 +1,113 @@
+/*********************************************************************
+** Program Filename: WinEstimator.cpp
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Implements functions declared in the WinEstimator header.
+** Input: None
+** Output: None
+*********************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include "Simulation.h"
+#include "StudentPolicy.h"
+#include "WinEstimator.h"
+
+/*********************************************************************
+** Function: EstimateWinProbability
+** Description: Estimates the probability that a student policy satisfies the
+ * instructor within a number of turns, starting from the maze's current
+ * state, by playing many randomized games in parallel.
+** Parameters: maze is the game to start from; opts are the options.
+** Pre-Conditions: None
+** Post-Conditions: The maze is unchanged; throws if the policy is unknown.
+*********************************************************************/
+WinEstimate EstimateWinProbability(Maze& maze,
+    const WinEstimateOptions& opts) {
+  // Each rollout makes its own policy; this one only checks the name.
+  std::unique_ptr<StudentPolicy> known(
+      MakeStudentPolicy(opts.policy, 0).UnwrapOr(nullptr));
+  if (!known)
+    throw std::invalid_argument("Unknown student policy: " + opts.policy + ".");
+
+  std::ostringstream saved;
+  maze.SaveCheckpoint(saved);
+  const std::string state = saved.str();
+
+  // Results are kept per rollout and totaled afterwards, so which thread
+  // played a rollout makes no difference.
+  std::vector<GameOutcome> outcomes(opts.rollouts);
+  std::atomic<unsigned long> next(0);
+
+  // Every thread copies the maze, so don't start more than there is work for.
+  unsigned long threads = std::min<unsigned long>(opts.threads, opts.rollouts);
+  if (threads == 0) threads = 1;
+  ParallelFor(threads, static_cast<unsigned>(threads), [&](unsigned long) {
+      Maze copy(maze);
+
+      for (;;) {
+        unsigned long i = next.fetch_add(1);
+        if (i >= opts.rollouts) return;
+
+        std::istringstream is(state);
+        copy.LoadCheckpoint(is);
+
+        Rng stream = Rng::ForStream(opts.seed, i);
+        copy.Reseed(stream.Next());
+        std::unique_ptr<StudentPolicy> policy(
+            MakeStudentPolicy(opts.policy, stream.Next()).Unwrap());
+        copy.set_student_policy(policy.get());
+
+        outcomes[i] = PlayHeadlessGame(copy, opts.max_turns);
+        copy.set_student_policy(nullptr);
+      }
+  });
+
+  WinEstimate estimate;
+  estimate.rollouts = opts.rollouts;
+  for (const GameOutcome& outcome : outcomes) {
+    if (outcome.satisfied_instructor) ++estimate.wins;
+    estimate.turns += outcome.turns;
+  }
+
+  if (estimate.rollouts != 0) {
+    estimate.probability =
+        static_cast<double>(estimate.wins) / estimate.rollouts;
+  }
+  WilsonInterval(estimate.wins, estimate.rollouts, opts.z, estimate.lower,
+                 estimate.upper);
+  return estimate;
+}
+
+/*********************************************************************
+** Function: WilsonInterval
+** Description: Computes the Wilson score interval for a binomial proportion,
+ * which (unlike the normal approximation) stays within [0, 1] and behaves
+ * well when there are few wins or losses.
+** Parameters: wins is the number of successes; trials is the number of
+ * trials; z is the normal quantile of the confidence level; lower and upper
+ * receive the interval's bounds.
+** Pre-Conditions: None
+** Post-Conditions: With no trials, the interval is [0, 1].
+*********************************************************************/
+void WilsonInterval(unsigned long wins, unsigned long trials, double z,
+    double& lower, double& upper) {
+  if (trials == 0) {
+    lower = 0;
+    upper = 1;
+    return;
+  }
+
+  double n = static_cast<double>(trials);
+  double p = wins / n;
+  double z2 = z * z;
+  double denom = 1 + z2 / n;
+  double center = (p + z2 / (2 * n)) / denom;
+  double half = z * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / denom;
+
+  lower = std::max(0.0, center - half);
+  upper = std::min(1.0, center + half);
+}
@@ -0,0 +1,50 @@
+#ifndef ESCAPEFROMCS162_WINESTIMATOR_H
+#define ESCAPEFROMCS162_WINESTIMATOR_H
+/*********************************************************************
+** Program Filename: WinEstimator.h
+** Author: Jason Chen
+** Date: 03/19/2018
+** Description: Declares functions for estimating how likely a student policy
+ * is to win a game from a given state.
+** Input: None
+** Output: None
+*********************************************************************/
+
+
+#include <cstdint>
+#include <string>
+#include "Maze.h"
+#include "Parallel.h"
+
+// Options for EstimateWinProbability.
+struct WinEstimateOptions {
+  unsigned long rollouts = 1000;
+  unsigned long max_turns = 10000;
+  std::string policy = "random";
+  std::uint64_t seed = 0;
+  unsigned threads = DefaultThreadCount();
+  // The normal quantile of the confidence level (1.96 for 95%).
+  double z = 1.96;
+};
+
+// The fraction of rollouts the policy won, with a Wilson score interval for
+// the true probability of winning.
+struct WinEstimate {
+  unsigned long rollouts = 0;
+  unsigned long wins = 0;
+  unsigned long turns = 0;
+  double probability = 0;
+  double lower = 0;
+  double upper = 0;
+};
+
+// Plays opts.rollouts games from the maze's current state, each with its own
+// generators (stream i of opts.seed for rollout i), so the estimate depends
+// only on the state, the options' seed, and the rollout count, however many
+// threads share the work. Each thread plays on its own copy of the maze.
+WinEstimate EstimateWinProbability(Maze& maze, const WinEstimateOptions& opts);
+void WilsonInterval(unsigned long wins, unsigned long trials, double z,
+    double& lower, double& upper);
+
+
+#endif //ESCAPEFROMCS162_WINESTIMATOR_H